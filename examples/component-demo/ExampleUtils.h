@@ -56,15 +56,15 @@ struct ConcreteCM : sst::jucegui::data::ContinuousModulatable
     {
         value = f;
         for (auto *l : guilisteners)
-            l->dataChanged();
+            l->valueChanged();
         for (auto *l : modellisteners)
-            l->dataChanged();
+            l->valueChanged();
     }
     void setValueFromModel(const float &f) override
     {
         value = f;
         for (auto *l : guilisteners)
-            l->dataChanged();
+            l->valueChanged();
     }
 
     float min{0}, max{1};
@@ -0,0 +1,133 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/components/Label.h>
+#include <sst/jucegui/style/StyleAndSettingsConsumer.h>
+
+#include "SelfCheck.h"
+
+using namespace sst::jucegui;
+namespace sc = sst::jucegui::selfcheck;
+
+namespace
+{
+// A root with panels of leaves, every one of them a style and settings consumer
+struct Tree
+{
+    components::Label root;
+    std::vector<std::unique_ptr<components::Label>> panels, leaves;
+
+    Tree(int panelCount, int leavesPerPanel)
+    {
+        for (int i = 0; i < panelCount; ++i)
+        {
+            auto p = std::make_unique<components::Label>();
+            root.addAndMakeVisible(*p);
+            for (int j = 0; j < leavesPerPanel; ++j)
+            {
+                auto l = std::make_unique<components::Label>();
+                p->addAndMakeVisible(*l);
+                leaves.push_back(std::move(l));
+            }
+            panels.push_back(std::move(p));
+        }
+    }
+
+    size_t size() const { return 1 + panels.size() + leaves.size(); }
+};
+
+// The walk setStyle and setSettings did before the roster: std::function recursion with
+// a dynamic_cast and a repaint per child, without any of the style work itself
+size_t recursiveWalk(juce::Component *top)
+{
+    size_t found{0};
+    std::function<void(juce::Component *)> rec;
+    rec = [&rec, &found](juce::Component *comp) {
+        for (auto c : comp->getChildren())
+        {
+            if (dynamic_cast<style::StyleConsumer *>(c))
+            {
+                found++;
+                c->repaint();
+            }
+            rec(c);
+        }
+    };
+    rec(top);
+    return found;
+}
+} // namespace
+
+SST_SELF_CHECK("roster: a restyle reaches every consumer, including ones added since")
+{
+    auto dark = style::StyleSheet::getBuiltInStyleSheet(style::StyleSheet::DARK);
+    auto light = style::StyleSheet::getBuiltInStyleSheet(style::StyleSheet::LIGHT);
+
+    Tree t(10, 10);
+    t.root.setStyle(dark);
+    for (auto &l : t.leaves)
+        SST_REQUIRE(l->style() == dark);
+
+    components::Label extra;
+    t.panels[3]->addAndMakeVisible(extra);
+    t.root.setStyle(light);
+    SST_REQUIRE(extra.style() == light);
+    for (auto &l : t.leaves)
+        SST_REQUIRE(l->style() == light);
+
+    t.panels[3]->removeChildComponent(&extra);
+    t.root.setStyle(dark);
+    SST_REQUIRE(t.leaves.back()->style() == dark);
+}
+
+SST_SELF_BENCH("roster: restyling and resetting a 10k component tree")
+{
+    auto dark = style::StyleSheet::getBuiltInStyleSheet(style::StyleSheet::DARK);
+    auto light = style::StyleSheet::getBuiltInStyleSheet(style::StyleSheet::LIGHT);
+    auto sa = std::make_shared<style::Settings>(style::Settings::getDefault());
+    auto sb = std::make_shared<style::Settings>(style::Settings::getDefault());
+
+    Tree t(100, 100);
+    bool flip{false};
+    auto restyle = sc::nanosPerCall(50, [&]() { t.root.setStyle((flip = !flip) ? dark : light); });
+    auto resettings = sc::nanosPerCall(50, [&]() { t.root.setSettings((flip = !flip) ? sa : sb); });
+
+    // Adding and removing a child dirties the roster, so each restyle rebuilds it first
+    components::Label spare;
+    auto rebuildAndRestyle = sc::nanosPerCall(50, [&]() {
+        t.panels[0]->addChildComponent(spare);
+        t.root.setStyle((flip = !flip) ? dark : light);
+        t.panels[0]->removeChildComponent(&spare);
+    });
+
+    size_t found{0};
+    auto walk = sc::nanosPerCall(50, [&]() { found = recursiveWalk(&t.root); });
+    SST_REQUIRE(found + 1 == t.size());
+
+    sc::report("components in the tree", (double)t.size(), "");
+    sc::report("setStyle through the roster", restyle / 1000, "us");
+    sc::report("setSettings through the roster", resettings / 1000, "us");
+    sc::report("setStyle after the tree changed, rebuilding the roster", rebuildAndRestyle / 1000,
+               "us");
+    sc::report("the recursive walk alone, which setStyle used to do", walk / 1000, "us");
+}
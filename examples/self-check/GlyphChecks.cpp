@@ -0,0 +1,102 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <chrono>
+#include <iterator>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/components/GlyphPainter.h>
+
+#if SST_JUCEGUI_PRECOMPILED_GLYPHS
+#include <cmrc/cmrc.hpp>
+#include "GlyphPathData.h"
+
+CMRC_DECLARE(sst::jucegui::resources);
+#endif
+
+#include "SelfCheck.h"
+
+using sst::jucegui::components::GlyphPainter;
+namespace sc = sst::jucegui::selfcheck;
+
+SST_SELF_BENCH("glyphs: building every glyph once, then painting every glyph")
+{
+    static constexpr int glyphCount{GlyphPainter::SHORTCIRCUIT_LOGO + 1};
+
+    // Only the first call does any work, so time it once rather than with nanosPerCall.
+    // Each paint used to pay for building its glyph, so the per glyph share of this is
+    // what every glyph paint cost before the cache.
+    auto t0 = std::chrono::steady_clock::now();
+    GlyphPainter::preloadAll();
+    auto t1 = std::chrono::steady_clock::now();
+    auto preload = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+    auto img = juce::Image(juce::Image::ARGB, 64, 64, true);
+    auto g = juce::Graphics(img);
+    for (auto size : {12, 16, 24, 48})
+    {
+        auto r = juce::Rectangle<int>(0, 0, size, size);
+        auto perPass = sc::nanosPerCall(200, [&]() {
+            for (int gt = 0; gt < glyphCount; ++gt)
+                GlyphPainter::paintGlyph(g, r, (GlyphPainter::GlyphType)gt, juce::Colours::white);
+        });
+        sc::report("paint a glyph at " + std::to_string(size) + "px", perPass / glyphCount, "ns");
+    }
+    sc::report("build a glyph (preloadAll, per glyph)", preload / glyphCount, "ns");
+}
+
+#if SST_JUCEGUI_PRECOMPILED_GLYPHS
+SST_SELF_BENCH("glyphs: building from compiled path data against parsing the SVGs")
+{
+    namespace gp = sst::jucegui::components::glyph_paths;
+    auto fs = cmrc::sst::jucegui::resources::get_filesystem();
+    auto glyphCount = (double)std::size(gp::glyphs);
+
+    // What SvgGlyphCache::entryFor does for a glyph without path data
+    auto parsed = sc::nanosPerCall(20, [&fs]() {
+        for (const auto &glyph : gp::glyphs)
+        {
+            auto f = fs.open(glyph.resource);
+            auto d = juce::Drawable::createFromImageData(f.begin(), f.size());
+        }
+    });
+
+    // and what SvgGlyphCache::loadPrecompiled does instead
+    auto compiled = sc::nanosPerCall(20, []() {
+        for (const auto &glyph : gp::glyphs)
+        {
+            for (size_t i = 0; i < glyph.numLayers; ++i)
+            {
+                const auto &src = glyph.layers[i];
+                auto outline = juce::Path(), stroke = juce::Path(), clip = juce::Path();
+                outline.loadPathFromData(src.path, src.pathSize);
+                if (src.strokeWidth > 0)
+                    juce::PathStrokeType(src.strokeWidth,
+                                         (juce::PathStrokeType::JointStyle)src.strokeJoin,
+                                         (juce::PathStrokeType::EndCapStyle)src.strokeCap)
+                        .createStrokedPath(stroke, outline);
+                if (src.clip)
+                    clip.loadPathFromData(src.clip, src.clipSize);
+            }
+        }
+    });
+
+    sc::report("parse a glyph SVG", parsed / glyphCount, "ns");
+    sc::report("build a glyph from compiled path data", compiled / glyphCount, "ns");
+}
+#endif
@@ -0,0 +1,341 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/components/Knob.h>
+#include "sst/jucegui/components/KnobPainter.hxx"
+
+#include <sst/jucegui/data/Continuous.h>
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include "SelfCheck.h"
+
+using sst::jucegui::components::KnobArcGeometry;
+namespace sc = sst::jucegui::selfcheck;
+
+namespace
+{
+/*
+ * The arc as knobs drew it before KnobArcGeometry: an addArc path on the ring, stroked
+ * with butt ends. This is the reference the filled sector outlines are compared with.
+ */
+juce::Path strokedArc(int width, int strokeWidth, float startV, float endV, float lineWidth)
+{
+    float dPath = 0.2;
+    float dAng = juce::MathConstants<float>::pi * (1 - dPath);
+    float startA = dAng * (2 * startV - 1);
+    float endA = dAng * (2 * endV - 1);
+
+    auto region = juce::Rectangle<int>(0, 0, width, width).toFloat().reduced(strokeWidth * 0.5 + 1);
+    auto p = juce::Path();
+    p.startNewSubPath(region.getCentre().toFloat());
+    p.addArc(region.getX(), region.getY(), region.getWidth(), region.getHeight(), startA, endA,
+             true);
+
+    auto res = juce::Path();
+    juce::PathStrokeType(lineWidth).createStrokedPath(res, p);
+    return res;
+}
+
+juce::Image render(const juce::Path &p, int width, float scale)
+{
+    auto px = (int)std::ceil(width * scale);
+    auto img = juce::Image(juce::Image::ARGB, px, px, true);
+    {
+        auto g = juce::Graphics(img);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        g.setColour(juce::Colours::white);
+        g.fillPath(p);
+    }
+    return img;
+}
+
+struct ImageDiff
+{
+    int maxDiff{0};
+    // summed alpha difference over summed reference alpha
+    double relativeError{0};
+};
+
+ImageDiff diff(const juce::Image &ref, const juce::Image &test)
+{
+    auto res = ImageDiff();
+    double total{0}, err{0};
+    for (int y = 0; y < ref.getHeight(); ++y)
+    {
+        for (int x = 0; x < ref.getWidth(); ++x)
+        {
+            auto a = (int)ref.getPixelAt(x, y).getAlpha();
+            auto b = (int)test.getPixelAt(x, y).getAlpha();
+            res.maxDiff = std::max(res.maxDiff, std::abs(a - b));
+            total += a;
+            err += std::abs(a - b);
+        }
+    }
+    res.relativeError = total > 0 ? err / total : 0;
+    return res;
+}
+
+// The largest difference in any channel of any pixel
+int maxChannelDiff(const juce::Image &ref, const juce::Image &test)
+{
+    auto res = 0;
+    for (int y = 0; y < ref.getHeight(); ++y)
+    {
+        for (int x = 0; x < ref.getWidth(); ++x)
+        {
+            auto a = ref.getPixelAt(x, y), b = test.getPixelAt(x, y);
+            for (auto [ca, cb] : {std::pair{a.getAlpha(), b.getAlpha()},
+                                  std::pair{a.getRed(), b.getRed()},
+                                  std::pair{a.getGreen(), b.getGreen()},
+                                  std::pair{a.getBlue(), b.getBlue()}})
+                res = std::max(res, std::abs((int)ca - (int)cb));
+        }
+    }
+    return res;
+}
+
+struct ArcCase
+{
+    float startV, endV, widthScale;
+};
+
+// Gutter, bipolar gutter halves, value arcs either way round, modulation and handle arcs,
+// as knobPainter draws them
+std::vector<ArcCase> arcCasesFor(const KnobArcGeometry &geom)
+{
+    auto h = geom.handleAng;
+    return {
+        {0, 1, 1},
+        {0, 0.5f - h, 1},
+        {0.5f + h, 1, 1},
+        {0.2f, 0.73f, 1},
+        {0, 0.37f, 1},
+        {0.3f, 0.6f, 0.7f},
+        {0.05f - h, 0.05f + h, 1},
+        {0.5f - h, 0.5f + h, 1},
+        {0.93f - h, 0.93f + h, 1},
+        {1, 0.4f, 1},
+        {0.5f, 0.2f, 1},
+        {0.5f + h, 0.5f - h, 1},
+    };
+}
+
+struct Param : sst::jucegui::data::Continuous
+{
+    float value{0};
+    std::string getLabel() const override { return "Param"; }
+    float getValue() const override { return value; }
+    float getDefaultValue() const override { return 0.5f; }
+    void setValueFromGUI(const float &f) override { setValueFromModel(f); }
+    void setValueFromModel(const float &f) override
+    {
+        value = f;
+        for (auto *l : guilisteners)
+            l->dataChanged();
+    }
+};
+} // namespace
+
+SST_SELF_CHECK("knob: filled arc geometry matches the stroked arcs")
+{
+    // Both shapes cover the same area up to edges that move by a fraction of a pixel, which
+    // is at most a quarter of a pixel's coverage anywhere and a couple of percent overall on
+    // the thinnest rings. A real shape change moves whole pixels and fails both.
+    static constexpr int maxPixelDiff{64};
+    static constexpr double maxRelativeError{0.03};
+
+    for (auto width : {14, 20, 24, 32, 40, 48, 64, 90, 128})
+    {
+        for (auto strokeWidth : {2, 3, 5, 8})
+        {
+            if (strokeWidth * 3 > width)
+                continue;
+
+            auto geom = KnobArcGeometry(width, strokeWidth);
+            for (const auto &c : arcCasesFor(geom))
+            {
+                for (auto scale : {1.f, 2.f})
+                {
+                    auto lw = strokeWidth * c.widthScale;
+                    auto ref = render(strokedArc(width, strokeWidth, c.startV, c.endV, lw),
+                                      width, scale);
+                    auto test = render(geom.arc(c.startV, c.endV, lw), width, scale);
+                    auto d = diff(ref, test);
+                    if (d.maxDiff > maxPixelDiff || d.relativeError > maxRelativeError)
+                        std::cout << "    width=" << width << " stroke=" << strokeWidth
+                                  << " arc=" << c.startV << ".." << c.endV << " scale=" << scale
+                                  << " maxDiff=" << d.maxDiff << " err=" << d.relativeError
+                                  << std::endl;
+                    SST_REQUIRE(d.maxDiff <= maxPixelDiff);
+                    SST_REQUIRE(d.relativeError <= maxRelativeError);
+                }
+            }
+        }
+    }
+}
+
+SST_SELF_CHECK("knob: cached layers match painting directly at fractional device offsets")
+{
+    using sst::jucegui::components::Knob;
+    using sst::jucegui::components::setKnobLayerCaching;
+    using sst::jucegui::style::StyleSheet;
+
+    // At 125% odd positions land a quarter, half or three quarters into a device pixel.
+    // Layers blitted there without snapping are resampled, which moves edge pixels by far
+    // more than compositing a layer rather than painting it does.
+    static constexpr float scale{1.25f};
+    static constexpr int panelSize{80}, knobSize{48}, maxPixelDiff{8};
+
+    auto param = Param();
+    param.value = 0.3f;
+    auto panel = juce::Component();
+    auto knob = Knob();
+    knob.setDrawLabel(false);
+    knob.setSource(&param);
+    knob.setStyle(StyleSheet::getBuiltInStyleSheet(StyleSheet::DARK));
+    panel.setBounds(0, 0, panelSize, panelSize);
+    panel.addAndMakeVisible(knob);
+
+    auto renderPanel = [&panel]() {
+        auto px = (int)std::ceil(panelSize * scale);
+        auto img = juce::Image(juce::Image::ARGB, px, px, true);
+        auto g = juce::Graphics(img);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        panel.paintEntireComponent(g, false);
+        return img;
+    };
+
+    for (auto [x, y] : {std::pair{4, 4}, std::pair{13, 7}, std::pair{9, 10}, std::pair{11, 3}})
+    {
+        knob.setBounds(x, y, knobSize, knobSize);
+        setKnobLayerCaching(false);
+        auto ref = renderPanel();
+        setKnobLayerCaching(true);
+        renderPanel();
+        auto d = maxChannelDiff(ref, renderPanel());
+        if (d > maxPixelDiff)
+            std::cout << "    knob at " << x << "," << y << " maxDiff=" << d << std::endl;
+        SST_REQUIRE(d <= maxPixelDiff);
+    }
+}
+
+SST_SELF_BENCH("knob: stroked arcs against filled arc geometry")
+{
+    static constexpr int width{48}, strokeWidth{5};
+    auto geom = KnobArcGeometry(width, strokeWidth);
+    auto img = juce::Image(juce::Image::ARGB, width, width, true);
+    auto g = juce::Graphics(img);
+    g.setColour(juce::Colours::white);
+
+    float v{0};
+    auto next = [&v]() {
+        v += 0.013f;
+        if (v > 1)
+            v -= 1;
+        return v;
+    };
+
+    auto stroked = sc::nanosPerCall(20000, [&]() {
+        auto p = juce::Path();
+        p.addArc(3.5f, 3.5f, 41, 41, -2.5f, -2.5f + 5 * next(), true);
+        g.strokePath(p, juce::PathStrokeType(strokeWidth));
+    });
+    auto filled = sc::nanosPerCall(20000, [&]() { g.fillPath(geom.arc(0, next(), strokeWidth)); });
+    auto built = sc::nanosPerCall(20000, [&]() {
+        auto gm = KnobArcGeometry(width, strokeWidth);
+        juce::ignoreUnused(gm);
+    });
+
+    sc::report("build and stroke an addArc path", stroked, "ns");
+    sc::report("build and fill a KnobArcGeometry sector", filled, "ns");
+    sc::report("build a KnobArcGeometry (once per knob size)", built, "ns");
+}
+
+SST_SELF_BENCH("knob: a 200 knob panel during automation playback")
+{
+    using sst::jucegui::components::Knob;
+    using sst::jucegui::style::StyleSheet;
+    static constexpr int knobCount{200}, knobSize{48}, frames{60};
+
+    // A private copy of the dark sheet, so recolouring it below restyles nothing else
+    auto theme = StyleSheet::getBuiltInStyleSheet(StyleSheet::DARK)->toBinaryTheme();
+    auto sheet = StyleSheet::fromBinaryTheme(theme.data(), theme.size());
+
+    std::vector<std::unique_ptr<Param>> params;
+    std::vector<std::unique_ptr<Knob>> knobs;
+    for (int i = 0; i < knobCount; ++i)
+    {
+        params.push_back(std::make_unique<Param>());
+        auto k = std::make_unique<Knob>();
+        k->setDrawLabel(false);
+        k->setSource(params.back().get());
+        k->setStyle(sheet);
+        k->setBounds(0, 0, knobSize, knobSize);
+        knobs.push_back(std::move(k));
+    }
+
+    auto img = juce::Image(juce::Image::ARGB, knobSize, knobSize, true);
+    auto g = juce::Graphics(img);
+
+    /*
+     * Each frame moves every knob along the sweep and then paints the panel; only the
+     * painting is timed. With forceMisses the gutter and body colours change every frame,
+     * so every static layer is painted again, as it was on every paint before the cache
+     * (plus the cost of keeping the new layer).
+     */
+    uint32_t recolour{0};
+    auto playback = [&](bool forceMisses) {
+        double ns{0};
+        for (int f = 0; f < frames; ++f)
+        {
+            if (forceMisses)
+            {
+                recolour++;
+                sheet->setColour(Knob::Styles::styleClass, Knob::Styles::gutter,
+                                 juce::Colour(0xFF202020u + recolour));
+                sheet->setColour(Knob::Styles::styleClass, Knob::Styles::knobbase,
+                                 juce::Colour(0xFF404040u + recolour));
+            }
+            for (int i = 0; i < knobCount; ++i)
+                params[(size_t)i]->setValueFromModel(0.5f + 0.5f * std::sin(0.1f * (float)(f + i)));
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (auto &k : knobs)
+                k->paint(g);
+            auto t1 = std::chrono::steady_clock::now();
+            ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        return ns / frames;
+    };
+
+    playback(false);
+    auto cached = playback(false);
+    auto missed = playback(true);
+
+    sc::report("paint 200 knobs, static layers cached", cached / 1000, "us");
+    sc::report("paint 200 knobs, static layers painted afresh", missed / 1000, "us");
+}
@@ -0,0 +1,61 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include "SelfCheck.h"
+
+int main(int argc, char **argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    sst::jucegui::style::StyleSheet::initializeStyleSheets([]() {});
+
+    // --bench runs the benchmarks rather than the checks; any other argument filters by name
+    bool bench{false};
+    std::string filter;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto a = std::string(argv[i]);
+        if (a == "--bench")
+            bench = true;
+        else
+            filter = a;
+    }
+
+    namespace sc = sst::jucegui::selfcheck;
+    int ran{0};
+    for (const auto &c : sc::checks())
+    {
+        if (c.isBenchmark != bench)
+            continue;
+        if (!filter.empty() && c.name.find(filter) == std::string::npos)
+            continue;
+        if (bench)
+            std::cout << c.name << std::endl;
+        auto before = sc::failures();
+        c.run();
+        if (!bench)
+            std::cout << (sc::failures() == before ? "[ ok ] " : "[FAIL] ") << c.name
+                      << std::endl;
+        ran++;
+    }
+    std::cout << ran << (bench ? " benchmarks, " : " checks, ") << sc::failures() << " failures"
+              << std::endl;
+    return sc::failures() == 0 ? 0 : 1;
+}
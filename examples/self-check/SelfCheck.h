@@ -0,0 +1,106 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#ifndef SSTJUCEGUI_EXAMPLES_SELF_CHECK_SELFCHECK_H
+#define SSTJUCEGUI_EXAMPLES_SELF_CHECK_SELFCHECK_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ * A very small check runner for behaviour which the component demo can't show by eye.
+ * Each check registers itself with SST_SELF_CHECK and reports failures with
+ * SST_REQUIRE; the runner returns non zero if any failed, so ctest can drive it.
+ *
+ * SST_SELF_BENCH registers a benchmark instead. Benchmarks only run with --bench, and
+ * print what they measured with report() rather than pass or fail.
+ */
+namespace sst::jucegui::selfcheck
+{
+struct Check
+{
+    std::string name;
+    std::function<void()> run;
+    bool isBenchmark{false};
+};
+
+inline std::vector<Check> &checks()
+{
+    static std::vector<Check> res;
+    return res;
+}
+
+inline int &failures()
+{
+    static int res{0};
+    return res;
+}
+
+struct Registrar
+{
+    Registrar(const std::string &name, std::function<void()> fn, bool isBenchmark = false)
+    {
+        checks().push_back({name, std::move(fn), isBenchmark});
+    }
+};
+
+// Mean nanoseconds per call of fn over n calls, after a short warm up
+template <typename F> double nanosPerCall(int n, F &&fn)
+{
+    for (int i = 0; i < std::max(n / 10, 1); ++i)
+        fn();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+inline void report(const std::string &what, double value, const std::string &unit)
+{
+    std::cout << "    " << std::left << std::setw(56) << what << std::right << std::setw(12)
+              << std::fixed << std::setprecision(1) << value << " " << unit << std::endl;
+}
+} // namespace sst::jucegui::selfcheck
+
+#define SST_SELF_CHECK_CAT2(a, b) a##b
+#define SST_SELF_CHECK_CAT(a, b) SST_SELF_CHECK_CAT2(a, b)
+#define SST_SELF_CHECK_REGISTER(name, isBenchmark)                                                 \
+    static void SST_SELF_CHECK_CAT(selfCheck_, __LINE__)();                                        \
+    static sst::jucegui::selfcheck::Registrar SST_SELF_CHECK_CAT(selfCheckReg_, __LINE__)(        \
+        name, SST_SELF_CHECK_CAT(selfCheck_, __LINE__), isBenchmark);                              \
+    static void SST_SELF_CHECK_CAT(selfCheck_, __LINE__)()
+#define SST_SELF_CHECK(name) SST_SELF_CHECK_REGISTER(name, false)
+#define SST_SELF_BENCH(name) SST_SELF_CHECK_REGISTER(name, true)
+
+#define SST_REQUIRE(cond)                                                                          \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(cond))                                                                               \
+        {                                                                                          \
+            std::cout << "    FAILED: " << #cond << " (" << __FILE__ << ":" << __LINE__ << ")"    \
+                      << std::endl;                                                                \
+            sst::jucegui::selfcheck::failures()++;                                                 \
+        }                                                                                          \
+    } while (0)
+
+#endif // SSTJUCEGUI_EXAMPLES_SELF_CHECK_SELFCHECK_H
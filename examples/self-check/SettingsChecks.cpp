@@ -0,0 +1,84 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <sst/jucegui/style/StyleAndSettingsConsumer.h>
+
+#include "SelfCheck.h"
+
+using namespace sst::jucegui::style;
+
+namespace
+{
+struct CountingConsumer : SettingsConsumer
+{
+    int changes{0};
+    void onSettingChanged(Settings::KeyIndex) override { changes++; }
+};
+} // namespace
+
+SST_SELF_CHECK("settings: a destroyed consumer leaves the default")
+{
+    auto &def = Settings::getDefault();
+    auto before = def->getSubscriberCount(Settings::MAX_REPAINT_HZ);
+    auto hz = def->get(Settings::maxRepaintHz);
+    {
+        CountingConsumer c;
+        c.subscribeToSetting(Settings::maxRepaintHz);
+        SST_REQUIRE(def->getSubscriberCount(Settings::MAX_REPAINT_HZ) == before + 1);
+    }
+    SST_REQUIRE(def->getSubscriberCount(Settings::MAX_REPAINT_HZ) == before);
+
+    // Would call into the dead consumer if it were still subscribed
+    def->set(Settings::maxRepaintHz, 30.f);
+    def->set(Settings::maxRepaintHz, hz);
+}
+
+SST_SELF_CHECK("settings: a destroyed consumer with its own settings subscribes nowhere")
+{
+    auto &def = Settings::getDefault();
+    auto before = def->getSubscriberCount(Settings::MAX_REPAINT_HZ);
+    auto own = std::make_shared<Settings>(def);
+    {
+        CountingConsumer c;
+        c.setSettings(own);
+        c.subscribeToSetting(Settings::maxRepaintHz);
+        SST_REQUIRE(own->getSubscriberCount(Settings::MAX_REPAINT_HZ) == 1);
+        SST_REQUIRE(def->getSubscriberCount(Settings::MAX_REPAINT_HZ) == before);
+    }
+    SST_REQUIRE(own->getSubscriberCount(Settings::MAX_REPAINT_HZ) == 0);
+    SST_REQUIRE(def->getSubscriberCount(Settings::MAX_REPAINT_HZ) == before);
+    own->set(Settings::maxRepaintHz, 30.f);
+}
+
+SST_SELF_CHECK("settings: subscriptions follow setSettings")
+{
+    auto &def = Settings::getDefault();
+    auto before = def->getSubscriberCount(Settings::MAX_REPAINT_HZ);
+    auto own = std::make_shared<Settings>(def);
+
+    CountingConsumer c;
+    c.subscribeToSetting(Settings::maxRepaintHz);
+    c.setSettings(own);
+    SST_REQUIRE(def->getSubscriberCount(Settings::MAX_REPAINT_HZ) == before);
+    SST_REQUIRE(own->getSubscriberCount(Settings::MAX_REPAINT_HZ) == 1);
+
+    own->set(Settings::maxRepaintHz, 30.f);
+    SST_REQUIRE(c.changes == 1);
+    c.setSettings(nullptr);
+    SST_REQUIRE(own->getSubscriberCount(Settings::MAX_REPAINT_HZ) == 0);
+    SST_REQUIRE(def->getSubscriberCount(Settings::MAX_REPAINT_HZ) == before + 1);
+}
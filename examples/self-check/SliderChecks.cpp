@@ -0,0 +1,226 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/components/HSlider.h>
+#include <sst/jucegui/components/HSliderFilled.h>
+#include <sst/jucegui/components/VSlider.h>
+#include <sst/jucegui/data/Continuous.h>
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include "SelfCheck.h"
+
+using namespace sst::jucegui;
+namespace sc = sst::jucegui::selfcheck;
+
+namespace
+{
+struct Param : data::Continuous
+{
+    float value{0};
+    std::string label{"Param"};
+    bool hidden{false};
+    std::string getLabel() const override { return label; }
+    bool isHidden() const override { return hidden; }
+    float getValue() const override { return value; }
+    float getDefaultValue() const override { return 0.5f; }
+    void setValueFromGUI(const float &f) override { setValueFromModel(f); }
+    void setValueFromModel(const float &f) override
+    {
+        value = f;
+        for (auto *l : guilisteners)
+            l->valueChanged();
+    }
+    // Anything but the value, as a host renaming or hiding a parameter would send it
+    void changed()
+    {
+        for (auto *l : guilisteners)
+            l->dataChanged();
+    }
+};
+
+// An automation curve; small steps, as a host sends at a typical block rate
+float automation(int step) { return 0.5f + 0.45f * std::sin(0.05f * (float)step); }
+
+/*
+ * Paints the slider, makes a change which returns the region the slider repaints for it,
+ * paints again, and counts the pixels which changed outside that region.
+ */
+template <typename S, typename F> int missedPixels(S &slider, F &&change)
+{
+    auto b = slider.getLocalBounds();
+    auto before = juce::Image(juce::Image::ARGB, b.getWidth(), b.getHeight(), true);
+    auto after = juce::Image(juce::Image::ARGB, b.getWidth(), b.getHeight(), true);
+    auto paintInto = [&slider](juce::Image &img) {
+        img.clear(img.getBounds());
+        auto g = juce::Graphics(img);
+        slider.paint(g);
+    };
+
+    paintInto(before);
+    juce::Rectangle<int> dirty = change();
+    paintInto(after);
+
+    int res{0};
+    for (int y = 0; y < b.getHeight(); ++y)
+        for (int x = 0; x < b.getWidth(); ++x)
+            if (!dirty.contains(x, y) && before.getPixelAt(x, y) != after.getPixelAt(x, y))
+                res++;
+    return res;
+}
+
+struct SweepResult
+{
+    // pixels which changed outside the repainted region
+    int missedPixels{0};
+    double repaintedFraction{0};
+};
+
+// Automation from the host, then the slider's own edits, along the same curve
+template <typename S> SweepResult sweep(S &slider, Param &param, int steps)
+{
+    auto b = slider.getLocalBounds();
+    auto res = SweepResult();
+    double area{0};
+    for (int i = 0; i < steps; ++i)
+    {
+        param.setValueFromModel(automation(i));
+        res.missedPixels += missedPixels(slider, [&]() {
+            param.setValueFromModel(automation(i + 1));
+            auto r = slider.getRepaintBounds(true);
+            area += (double)r.getWidth() * r.getHeight();
+            return r;
+        });
+        res.missedPixels += missedPixels(slider, [&]() {
+            auto r = juce::Rectangle<int>();
+            slider.writeOwnValue([&]() {
+                param.setValueFromGUI(automation(i));
+                r = slider.getRepaintBounds(false);
+            });
+            return r;
+        });
+    }
+    res.repaintedFraction = area / ((double)steps * b.getWidth() * b.getHeight());
+    return res;
+}
+
+// A rename and a hide, which sources only report as dataChanged
+template <typename S> int otherChangesMissed(S &slider, Param &param)
+{
+    int res{0};
+    res += missedPixels(slider, [&]() {
+        param.label = "A Much Longer Parameter Name";
+        param.changed();
+        return slider.getRepaintBounds(false);
+    });
+    res += missedPixels(slider, [&]() {
+        param.hidden = true;
+        param.changed();
+        return slider.getRepaintBounds(false);
+    });
+    param.hidden = false;
+    param.label = "Param";
+    param.changed();
+    return res;
+}
+
+// Mean paint time per automation step, painting everything or only the repainted region
+template <typename S> std::pair<double, double> paintTimes(S &slider, Param &param)
+{
+    auto b = slider.getLocalBounds();
+    auto img = juce::Image(juce::Image::ARGB, b.getWidth(), b.getHeight(), true);
+    auto g = juce::Graphics(img);
+
+    int step{0};
+    auto whole = sc::nanosPerCall(2000, [&]() {
+        param.setValueFromModel(automation(step++));
+        slider.paint(g);
+    });
+    auto region = sc::nanosPerCall(2000, [&]() {
+        param.setValueFromModel(automation(step++));
+        g.saveState();
+        g.reduceClipRegion(slider.getRepaintBounds(true));
+        slider.paint(g);
+        g.restoreState();
+    });
+    return {whole, region};
+}
+
+template <typename S> void setUp(S &slider, Param &param, int w, int h)
+{
+    slider.setStyle(style::StyleSheet::getBuiltInStyleSheet(style::StyleSheet::DARK));
+    slider.setSource(&param);
+    slider.setBounds(0, 0, w, h);
+}
+} // namespace
+
+SST_SELF_CHECK("sliders: value changes only alter the region they repaint")
+{
+    Param hp, fp, vp;
+    components::HSlider h;
+    components::HSliderFilled f;
+    components::VSlider v;
+    setUp(h, hp, 300, 32);
+    setUp(f, fp, 300, 24);
+    setUp(v, vp, 32, 300);
+
+    SST_REQUIRE(sweep(h, hp, 100).missedPixels == 0);
+    SST_REQUIRE(sweep(f, fp, 100).missedPixels == 0);
+    SST_REQUIRE(sweep(v, vp, 100).missedPixels == 0);
+}
+
+SST_SELF_CHECK("sliders: renames and hiding repaint everything they change")
+{
+    Param hp, fp, vp;
+    components::HSlider h;
+    components::HSliderFilled f;
+    components::VSlider v;
+    setUp(h, hp, 300, 32);
+    setUp(f, fp, 300, 24);
+    setUp(v, vp, 32, 300);
+
+    SST_REQUIRE(otherChangesMissed(h, hp) == 0);
+    SST_REQUIRE(otherChangesMissed(f, fp) == 0);
+    SST_REQUIRE(otherChangesMissed(v, vp) == 0);
+}
+
+SST_SELF_BENCH("sliders: repaint area and time during an automation sweep")
+{
+    Param hp, fp, vp;
+    components::HSlider h;
+    components::HSliderFilled f;
+    components::VSlider v;
+    setUp(h, hp, 300, 32);
+    setUp(f, fp, 300, 24);
+    setUp(v, vp, 32, 300);
+
+    auto reportFor = [](const std::string &name, auto &slider, Param &param) {
+        auto s = sweep(slider, param, 200);
+        auto [whole, region] = paintTimes(slider, param);
+        sc::report(name + ": repainted share of the slider", 100 * s.repaintedFraction, "%");
+        sc::report(name + ": paint the whole slider", whole, "ns");
+        sc::report(name + ": paint the repainted region", region, "ns");
+    };
+    reportFor("HSlider 300x32", h, hp);
+    reportFor("HSliderFilled 300x24", f, fp);
+    reportFor("VSlider 32x300", v, vp);
+}
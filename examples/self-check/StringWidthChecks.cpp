@@ -0,0 +1,67 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/components/NamedPanel.h>
+#include <sst/jucegui/style/StringWidthCache.h>
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include "SelfCheck.h"
+
+using namespace sst::jucegui;
+namespace sc = sst::jucegui::selfcheck;
+
+SST_SELF_BENCH("string widths: panel headers with and without the cache")
+{
+    using components::NamedPanel;
+
+    auto dark = style::StyleSheet::getBuiltInStyleSheet(style::StyleSheet::DARK);
+    auto font = dark->getFontHandle(NamedPanel::Styles::styleClass, NamedPanel::Styles::labelfont);
+    auto names = std::vector<juce::String>{"Oscillator 1", "Filter Envelope", "LFO 3 Shape",
+                                           "Output", "Modulation Matrix"};
+
+    size_t i{0};
+    float sink{0};
+    auto uncached = sc::nanosPerCall(20000, [&]() {
+        sink += SST_STRING_WIDTH_FLOAT_UNCACHED(font->font, names[i++ % names.size()]);
+    });
+    auto cached = sc::nanosPerCall(20000, [&]() {
+        sink += SST_STRING_WIDTH_FLOAT(*font, names[i++ % names.size()]);
+    });
+    juce::ignoreUnused(sink);
+
+    // Clearing the cache before each paint makes the header measure its label afresh, as
+    // it did on every paint before the cache
+    NamedPanel panel("Filter Envelope");
+    panel.setStyle(dark);
+    panel.setBounds(0, 0, 300, 200);
+    auto img = juce::Image(juce::Image::ARGB, 300, 200, true);
+    auto g = juce::Graphics(img);
+    auto warmPaint = sc::nanosPerCall(2000, [&]() { panel.paint(g); });
+    auto coldPaint = sc::nanosPerCall(2000, [&]() {
+        style::StringWidthCache::clear();
+        panel.paint(g);
+    });
+
+    sc::report("measure a header label", uncached, "ns");
+    sc::report("look a header label up in the cache", cached, "ns");
+    sc::report("paint a panel, measuring its label", coldPaint, "ns");
+    sc::report("paint a panel, with its label width cached", warmPaint, "ns");
+}
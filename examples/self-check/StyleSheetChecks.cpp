@@ -0,0 +1,208 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include "SelfCheck.h"
+
+using namespace sst::jucegui::style;
+namespace sc = sst::jucegui::selfcheck;
+
+namespace
+{
+using Pair = std::pair<const StyleSheet::Class *, const StyleSheet::Property *>;
+
+// Every registered colour pair the sheet has a value for, directly or by inheritance
+std::vector<Pair> colourPairs(const StyleSheet::ptr_t &sheet)
+{
+    auto res = std::vector<Pair>();
+    for (const auto &[c, ps] : StyleSheet::allProperties)
+        for (auto *p : ps)
+            if (p->type == StyleSheet::Property::COLOUR && sheet->hasColour(*c, *p))
+                res.emplace_back(c, p);
+    return res;
+}
+
+std::vector<Pair> fontPairs(const StyleSheet::ptr_t &sheet)
+{
+    auto res = std::vector<Pair>();
+    for (const auto &[c, ps] : StyleSheet::allProperties)
+        for (auto *p : ps)
+            if (p->type == StyleSheet::Property::FONT && sheet->hasFont(*c, *p))
+                res.emplace_back(c, p);
+    return res;
+}
+} // namespace
+
+SST_SELF_BENCH("stylesheet: resolved lookups against the first, walking lookup")
+{
+    auto dark = StyleSheet::getBuiltInStyleSheet(StyleSheet::DARK);
+    auto pairs = colourPairs(dark);
+    auto theme = dark->toBinaryTheme();
+
+    uint32_t sink{0};
+    auto lookupAll = [&pairs, &sink](const StyleSheet::ptr_t &s) {
+        for (const auto &[c, p] : pairs)
+            sink += s->getColour(*c, *p).getARGB();
+    };
+
+    // A freshly loaded sheet has an empty resolved grid, so its first lookup of each pair
+    // walks the base classes as every lookup used to; subtract the load to get the walks.
+    auto load = sc::nanosPerCall(200, [&theme]() {
+        auto s = StyleSheet::fromBinaryTheme(theme.data(), theme.size());
+    });
+    auto firstPass = sc::nanosPerCall(200, [&]() {
+        auto s = StyleSheet::fromBinaryTheme(theme.data(), theme.size());
+        lookupAll(s);
+    });
+    auto loaded = StyleSheet::fromBinaryTheme(theme.data(), theme.size());
+    lookupAll(loaded);
+    auto warmPass = sc::nanosPerCall(200, [&]() { lookupAll(loaded); });
+
+    juce::ignoreUnused(sink);
+    SST_REQUIRE(!pairs.empty());
+    sc::report("colour pairs looked up", (double)pairs.size(), "pairs");
+    sc::report("first lookup, walking the base classes", (firstPass - load) / pairs.size(), "ns");
+    sc::report("later lookups from the resolved grid", warmPass / pairs.size(), "ns");
+}
+
+SST_SELF_CHECK("stylesheet: binary and JSON themes round trip")
+{
+    auto dark = StyleSheet::getBuiltInStyleSheet(StyleSheet::DARK);
+    auto json = dark->toJsonTheme();
+    auto bin = dark->toBinaryTheme();
+
+    auto fromBin = StyleSheet::fromBinaryTheme(bin.data(), bin.size());
+    auto fromJson = StyleSheet::fromJsonTheme(json);
+    SST_REQUIRE(fromBin);
+    SST_REQUIRE(fromJson);
+    if (!fromBin || !fromJson)
+        return;
+
+    for (const auto &s : {fromBin, fromJson})
+    {
+        for (const auto &[c, p] : colourPairs(dark))
+            SST_REQUIRE(s->getColour(*c, *p) == dark->getColour(*c, *p));
+        for (const auto &[c, p] : fontPairs(dark))
+        {
+            auto f = s->getFont(*c, *p), d = dark->getFont(*c, *p);
+            SST_REQUIRE(f.getTypefaceName() == d.getTypefaceName());
+            SST_REQUIRE(f.getStyleFlags() == d.getStyleFlags());
+            SST_REQUIRE(f.getHeight() == d.getHeight());
+        }
+        SST_REQUIRE(s->getKnobRingStrokeWidth(48) == dark->getKnobRingStrokeWidth(48));
+    }
+
+    SST_REQUIRE(!StyleSheet::fromBinaryTheme(bin.data(), bin.size() / 2));
+    SST_REQUIRE(!StyleSheet::fromJsonTheme("{ \"not\": \"a theme\""));
+}
+
+SST_SELF_CHECK("stylesheet: themes keep font adjustments and replaced typefaces")
+{
+    auto dark = StyleSheet::getBuiltInStyleSheet(StyleSheet::DARK);
+    auto darkBin = dark->toBinaryTheme();
+    auto fonts = fontPairs(dark);
+    SST_REQUIRE(!fonts.empty());
+    if (fonts.empty())
+        return;
+
+    // Load each form of the sheet's theme, or nothing if either fails
+    auto roundTrips = [](const StyleSheet::ptr_t &s, const juce::Typeface::Ptr &tf) {
+        auto bin = s->toBinaryTheme();
+        auto res = std::vector<StyleSheet::ptr_t>{StyleSheet::fromBinaryTheme(bin.data(),
+                                                                              bin.size(), tf),
+                                                  StyleSheet::fromJsonTheme(s->toJsonTheme(), tf)};
+        for (const auto &r : res)
+            if (!r)
+                return std::vector<StyleSheet::ptr_t>();
+        return res;
+    };
+
+    auto adjusted = StyleSheet::fromBinaryTheme(darkBin.data(), darkBin.size());
+    adjusted->setFontHeightDelta(3);
+    adjusted->setFontExtraKerningFactor(0.1f);
+    auto loaded = roundTrips(adjusted, nullptr);
+    SST_REQUIRE(loaded.size() == 2);
+    for (const auto &s : loaded)
+    {
+        for (const auto &[c, p] : fonts)
+        {
+            auto f = s->getFont(*c, *p), a = adjusted->getFont(*c, *p);
+            SST_REQUIRE(f.getHeight() == a.getHeight());
+            SST_REQUIRE(f.getExtraKerningFactor() == a.getExtraKerningFactor());
+        }
+
+        // A later delta starts from the same baseline on both, so it doesn't compound
+        s->setFontHeightDelta(2);
+        adjusted->setFontHeightDelta(2);
+        for (const auto &[c, p] : fonts)
+            SST_REQUIRE(s->getFont(*c, *p).getHeight() == adjusted->getFont(*c, *p).getHeight());
+        adjusted->setFontHeightDelta(3);
+    }
+
+    auto typeface = dark->getFont(*fonts.front().first, *fonts.front().second).getTypefacePtr();
+    auto replaced = StyleSheet::fromBinaryTheme(darkBin.data(), darkBin.size());
+    replaced->replaceFontsWithTypeface(typeface);
+    auto bin = replaced->toBinaryTheme();
+    SST_REQUIRE(!StyleSheet::fromBinaryTheme(bin.data(), bin.size()));
+    SST_REQUIRE(!StyleSheet::fromJsonTheme(replaced->toJsonTheme()));
+
+    loaded = roundTrips(replaced, typeface);
+    SST_REQUIRE(loaded.size() == 2);
+    for (const auto &s : loaded)
+        for (const auto &[c, p] : fonts)
+        {
+            auto f = s->getFont(*c, *p);
+            SST_REQUIRE(f.getTypefacePtr() == typeface);
+            SST_REQUIRE(f.getHeight() == replaced->getFont(*c, *p).getHeight());
+        }
+}
+
+SST_SELF_BENCH("stylesheet: loading themes against building a sheet by hand")
+{
+    auto dark = StyleSheet::getBuiltInStyleSheet(StyleSheet::DARK);
+    auto bin = dark->toBinaryTheme();
+    auto json = dark->toJsonTheme();
+    auto blank = StyleSheet::getBuiltInStyleSheet(StyleSheet::EMPTY)->toBinaryTheme();
+
+    // The built in sheets are made once per process, so the construction a theme load
+    // replaces is stood in for by setting every value the dark sheet resolves on a blank
+    // sheet. That includes inherited values, so it is an upper bound.
+    auto colours = colourPairs(dark);
+    auto fonts = fontPairs(dark);
+    auto byHand = sc::nanosPerCall(200, [&]() {
+        auto s = StyleSheet::fromBinaryTheme(blank.data(), blank.size());
+        for (const auto &[c, p] : colours)
+            s->setColour(*c, *p, dark->getColour(*c, *p));
+        for (const auto &[c, p] : fonts)
+            s->setFont(*c, *p, dark->getFont(*c, *p));
+    });
+    auto fromBin = sc::nanosPerCall(200, [&]() {
+        auto s = StyleSheet::fromBinaryTheme(bin.data(), bin.size());
+    });
+    auto fromJson = sc::nanosPerCall(200, [&]() { auto s = StyleSheet::fromJsonTheme(json); });
+
+    sc::report("binary theme size", (double)bin.size(), "bytes");
+    sc::report("JSON theme size", (double)json.size(), "bytes");
+    sc::report("build the dark sheet with setColour and setFont", byHand / 1000, "us");
+    sc::report("load the dark sheet from a binary theme", fromBin / 1000, "us");
+    sc::report("load the dark sheet from a JSON theme", fromJson / 1000, "us");
+}
@@ -20,6 +20,7 @@
 
 #include <functional>
 #include <cassert>
+#include <memory>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <sst/jucegui/data/Continuous.h>
 
@@ -116,6 +117,140 @@ template <typename T> struct EditableComponentBase : public WithIdleTimer
     // JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditableComponentBase<T>)
 
     bool isHovered{false};
+
+    /*
+     * Opt-in coalescing of the value writes an edit gesture makes. By default every mouse
+     * event writes straight through to the data, which with a high rate mouse can mean
+     * hundreds of host parameter writes a second. With a rate set, the first write of a
+     * burst goes out at once and after that only the latest write is sent, at most hz
+     * times a second. Anything held is always sent before onEndEdit. Wheel edits, which
+     * have no end event, become one edit which ends once the writes go quiet.
+     *
+     * The widget draws from the data, so while coalescing it updates at the same rate.
+     * A rate of 0 (the default) turns coalescing off. A component which stops showing
+     * mid wheel edit ends it then (see endWheelEditIfHidden). Failing that, one destroyed
+     * mid wheel edit sends what it holds but not onEndEdit, since the derived widget the
+     * client's callback may look at is already gone by then.
+     */
+    void setValueEmissionRateHz(int hz)
+    {
+        flushValueWrite();
+        valueEmissionRateHz = hz;
+        if (hz <= 0)
+        {
+            if (wheelEditOpen)
+                endEdit();
+            valueEmissionTimer.reset();
+        }
+        else if (!valueEmissionTimer)
+        {
+            valueEmissionTimer = std::make_unique<ValueEmissionTimer>(*this);
+        }
+        else if (valueEmissionTimer->isTimerRunning())
+        {
+            valueEmissionTimer->startTimerHz(hz);
+        }
+    }
+    bool isCoalescingValueEmission() const { return valueEmissionRateHz > 0; }
+
+    // Start and finish an edit, closing any open wheel edit and sending any held write first
+    void beginEdit()
+    {
+        if (wheelEditOpen)
+            endEdit();
+        onBeginEdit();
+    }
+    void endEdit()
+    {
+        flushValueWrite();
+        wheelEditOpen = false;
+        onEndEdit();
+    }
+
+    // Wheel events begin and end an edit each, unless coalescing joins them into one
+    void beginWheelEdit()
+    {
+        if (wheelEditOpen)
+            return;
+        beginEdit();
+        wheelEditOpen = isCoalescingValueEmission();
+    }
+    void endWheelEdit()
+    {
+        if (!wheelEditOpen)
+            endEdit();
+    }
+    // Components call this as they stop showing, while they are still whole
+    void endWheelEditIfHidden()
+    {
+        if (wheelEditOpen && !asT()->isShowing())
+            endEdit();
+    }
+
+    // Make a value write now, or hold it as the latest if coalescing
+    void emitValueWrite(std::function<void()> write)
+    {
+        if (!isCoalescingValueEmission())
+        {
+            writeOwnValue(write);
+            return;
+        }
+        pendingValueWrite = std::move(write);
+        if (!valueEmissionTimer->isTimerRunning())
+        {
+            flushValueWrite();
+            valueEmissionTimer->startTimerHz(valueEmissionRateHz);
+        }
+    }
+    bool hasPendingValueWrite() const { return (bool)pendingValueWrite; }
+    void flushValueWrite()
+    {
+        if (!pendingValueWrite)
+            return;
+        auto w = std::move(pendingValueWrite);
+        pendingValueWrite = nullptr;
+        writeOwnValue(w);
+    }
+    // For when the data a held write points to goes away
+    void dropValueWrite() { pendingValueWrite = nullptr; }
+
+    /*
+     * Sources call dataChanged for any change at all (values, labels, hiding, bipolarity),
+     * so editors repaint everything for it. A write the editor makes itself can only have
+     * moved its value, so the dataChanged it provokes can repaint less.
+     */
+    template <typename F> void writeOwnValue(F &&write)
+    {
+        ownValueWrites++;
+        write();
+        ownValueWrites--;
+    }
+    bool isWritingOwnValue() const { return ownValueWrites > 0; }
+
+  protected:
+    struct ValueEmissionTimer : juce::Timer
+    {
+        explicit ValueEmissionTimer(EditableComponentBase<T> &o) : owner(o) {}
+        void timerCallback() override
+        {
+            if (owner.hasPendingValueWrite())
+            {
+                owner.flushValueWrite();
+                return;
+            }
+            // a quiet period, so the burst is over
+            stopTimer();
+            if (owner.wheelEditOpen)
+                owner.endEdit();
+        }
+        EditableComponentBase<T> &owner;
+    };
+
+    int valueEmissionRateHz{0};
+    int ownValueWrites{0};
+    bool wheelEditOpen{false};
+    std::function<void()> pendingValueWrite;
+    std::unique_ptr<ValueEmissionTimer> valueEmissionTimer;
 };
 
 template <typename T> struct Modulatable : public data::Continuous::DataListener
@@ -174,6 +309,7 @@ template <typename T> struct Modulatable : public data::Continuous::DataListener
 
     template <typename S> void setSource(S *s)
     {
+        sourceChanging();
         if (continuous())
             continuous()->removeGUIDataListener(this);
         source = s;
@@ -187,6 +323,7 @@ template <typename T> struct Modulatable : public data::Continuous::DataListener
 
     void clearSource()
     {
+        sourceChanging();
         if (continuous())
             continuous()->removeGUIDataListener(this);
         source = (data::ContinuousModulatable *)nullptr;
@@ -199,6 +336,9 @@ template <typename T> struct Modulatable : public data::Continuous::DataListener
         clearSource();
     }
 
+    // Called while the old source is still set, before setSource or clearSource replace it
+    virtual void sourceChanging() {}
+
     // Some gcc12 problems with this and we always have a parent class with same
     // JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Modulatable<T>)
 
@@ -18,6 +18,7 @@
 #ifndef INCLUDE_SST_JUCEGUI_COMPONENTS_CONTINUOUSPARAMEDITOR_H
 #define INCLUDE_SST_JUCEGUI_COMPONENTS_CONTINUOUSPARAMEDITOR_H
 
+#include <memory>
 #include <string>
 
 #include <juce_gui_basics/juce_gui_basics.h>
@@ -30,6 +31,7 @@
 #include "sst/jucegui/accessibility/AccessibilityConfiguration.h"
 #include "sst/jucegui/accessibility/AccessibilityKeyboardEdits.h"
 #include "sst/jucegui/accessibility/KeyboardTraverser.h"
+#include "sst/jucegui/util/VisibilityParentWatcher.h"
 
 namespace sst::jucegui::components
 {
@@ -102,9 +104,46 @@ struct ContinuousParamEditor
     void focusGained(juce::Component::FocusChangeType cause) override { startHover(); }
     void focusLost(juce::Component::FocusChangeType cause) override { endHover(); }
 
+    void visibilityChanged() override { endWheelEditIfHidden(); }
+    void parentHierarchyChanged() override { endWheelEditIfHidden(); }
+
     std::unique_ptr<juce::AccessibilityHandler> createAccessibilityHandler() override;
     void notifyAccessibleChange();
 
+    /*
+     * The part of the editor which moves with its value, in local coordinates. Editors
+     * which don't know better say everything.
+     */
+    virtual juce::Rectangle<int> getValueBounds() { return getLocalBounds(); }
+
+    /*
+     * What a change repaints. A value change (a valueChanged from the data, or anything
+     * our own write provoked) repaints the value as last painted and as it is now. Any
+     * other dataChanged may be a new label, hiding or bipolarity, so repaints everything.
+     */
+    juce::Rectangle<int> getRepaintBounds(bool valueOnly)
+    {
+        if (valueOnly || isWritingOwnValue())
+            return getValueBounds().getUnion(paintedValueBounds);
+        return getLocalBounds();
+    }
+    void repaintValue() { repaint(getRepaintBounds(true)); }
+    void dataChanged() override { repaint(getRepaintBounds(false)); }
+    void valueChanged() override { repaintValue(); }
+    void sourceVanished(data::Continuous *s) override
+    {
+        dropValueWrite();
+        Modulatable<ContinuousParamEditor>::sourceVanished(s);
+    }
+    // Held writes point at the old source, so send them (and end a wheel edit) before it goes
+    void sourceChanging() override
+    {
+        if (wheelEditOpen)
+            endEdit();
+        else
+            flushValueWrite();
+    }
+
     void initiateTypeIn();
     void dismissTypeIn();
     std::unique_ptr<juce::Component> typeInComponent;
@@ -112,6 +151,20 @@ struct ContinuousParamEditor
   protected:
     float mouseDownV0, mouseDownX0, mouseDownY0;
 
+    /*
+     * Set the value, or the modulation depth when editing modulation, through the write
+     * coalescing in EditableComponentBase. getEditedValue includes a write still held.
+     */
+    void emitEditedValue(float v, bool quantized);
+    float getEditedValue();
+    float heldValue{0.f};
+
+    // getValueBounds as of the last paint; editors overriding it set this when painting
+    juce::Rectangle<int> paintedValueBounds;
+
+    // Made with the first held wheel edit, so hiding a parent ends one too
+    std::unique_ptr<util::VisibilityParentWatcher> wheelEditVisibilityWatcher;
+
     enum MouseMode
     {
         NONE,
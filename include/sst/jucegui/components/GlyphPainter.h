@@ -157,9 +157,23 @@ struct GlyphPainter : public juce::Component,
      * also provides a static method to paint from other clients.
      * This metnod assumes the color is set *before* you call it
      * since it doesn't have a style sheet, just geometry.
+     *
+     * Shared glyph state is only touched under a lock, so this may also be
+     * called from a thread painting into an Image.
+     *
+     * Components painting a glyph pass themselves as owner, so the glyph lands on whole
+     * device pixels wherever the component sits; without one the graphics origin is
+     * taken to be on a whole device pixel, as it is for an Image.
      */
     static void paintGlyph(juce::Graphics &, const juce::Rectangle<int> &, GlyphType,
-                           const juce::Colour &as);
+                           const juce::Colour &as, const juce::Component *owner = nullptr);
+
+    /*
+     * SVG glyphs are built once, from path data compiled into the library, and kept
+     * for the life of the process. That happens on first paint unless you call this,
+     * say while the editor is being built, to take the cost up front.
+     */
+    static void preloadAll();
 };
 } // namespace sst::jucegui::components
 #endif // SHORTCIRCUITXT_GLYPHPAINTER_H
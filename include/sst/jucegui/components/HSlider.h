@@ -41,6 +41,7 @@ struct HSlider : public ContinuousParamEditor, public style::StyleConsumer
     ~HSlider();
 
     void paint(juce::Graphics &g) override;
+    juce::Rectangle<int> getValueBounds() override;
 
     void setShowLabel(bool b)
     {
@@ -27,6 +27,7 @@ struct HSliderFilled : public HSlider
     HSliderFilled();
 
     void paint(juce::Graphics &g) override;
+    juce::Rectangle<int> getValueBounds() override;
     int verticalReduction{0}; // if you want the paint zone smaller than the hit zone set this
     // to pixels to reduce vertically (both sids, so '1' takes 1 off top and bottom)
 
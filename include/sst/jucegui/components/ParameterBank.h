@@ -0,0 +1,212 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#ifndef INCLUDE_SST_JUCEGUI_COMPONENTS_PARAMETERBANK_H
+#define INCLUDE_SST_JUCEGUI_COMPONENTS_PARAMETERBANK_H
+
+#include <functional>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/style/StyleAndSettingsConsumer.h>
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include "ContinuousParamEditor.h"
+#include "Knob.h"
+#include "sst/jucegui/accessibility/AccessibilityConfiguration.h"
+#include "sst/jucegui/accessibility/AccessibilityKeyboardEdits.h"
+#include "sst/jucegui/util/VisibilityParentWatcher.h"
+
+namespace sst::jucegui::components
+{
+/*
+ * A single component which draws and edits many continuous parameters. Dense layouts
+ * (a mixer with hundreds of knobs, say) pay for a full Knob or slider component per
+ * parameter: a style consumer, an idle timer registration, an accessibility handler
+ * and a paint call each. A bank instead holds a small Cell per parameter, paints them
+ * all in one paint() through the same knob and slider painters those components use,
+ * hit tests the cells itself and repaints only the cell which changed.
+ *
+ * Cells resolve their colours against the knob, hslider or vslider style class, so a
+ * cell looks just like the component it stands in for. For screen readers and keyboard
+ * focus each cell gets a bare, mouse transparent child component carrying a slider
+ * accessibility handler; these have no style, timer or paint of their own.
+ */
+struct ParameterBank : public juce::Component,
+                       public style::StyleConsumer,
+                       public style::SettingsConsumer,
+                       public sst::jucegui::accessibility::AccessibilityConfiguration,
+                       public sst::jucegui::accessibility::AccessibilityKeyboardEditSupport<
+                           ParameterBank>
+{
+    enum CellKind
+    {
+        KNOB,
+        HSLIDER,
+        VSLIDER
+    };
+
+    using ModulationDisplay = ContinuousParamEditor::ModulationDisplay;
+    using PathDrawMode = Knob::PathDrawMode;
+
+    struct Cell : data::Continuous::DataListener
+    {
+        Cell(ParameterBank &b, int i, CellKind k) : bank(b), index(i), kind(k) {}
+        ~Cell();
+
+        ParameterBank &bank;
+        const int index;
+        const CellKind kind;
+
+        juce::Rectangle<int> bounds;
+        std::variant<data::Continuous *, data::ContinuousModulatable *> source{
+            (data::Continuous *)nullptr};
+
+        bool enabled{true};
+        bool isEditingMod{false};
+        ModulationDisplay modulationDisplay{ModulationDisplay::NONE};
+        bool alwaysQuantize{false};
+
+        // Knob cells
+        PathDrawMode pathDrawMode{Knob::FOLLOW_BIPOLAR};
+        bool drawLabel{true};
+        // HSlider cells
+        bool showLabel{true}, showValue{true};
+
+        data::Continuous *continuous();
+        data::ContinuousModulatable *continuousModulatable();
+
+        void dataChanged() override;
+        void sourceVanished(data::Continuous *s) override;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Cell)
+    };
+
+    ParameterBank();
+    ~ParameterBank();
+
+    // Add a cell, returning its index. Bounds are in bank coordinates.
+    int addCell(CellKind kind, data::Continuous *source, const juce::Rectangle<int> &bounds);
+    int addCell(CellKind kind, data::ContinuousModulatable *source,
+                const juce::Rectangle<int> &bounds);
+    void clearCells();
+
+    size_t getNumCells() const { return cells.size(); }
+    // Change cell state through this and then call repaintCell
+    Cell &getCell(int index) { return *cells[index]; }
+    void repaintCell(int index);
+
+    void setCellBounds(int index, const juce::Rectangle<int> &bounds);
+    void setCellEnabled(int index, bool b);
+    void setModulationDisplay(int index, ModulationDisplay d);
+    void setEditingModulation(int index, bool b);
+
+    // The cell under a point in bank coordinates, or -1
+    int cellAt(const juce::Point<float> &p) const;
+
+    // These are the EditableComponentBase callbacks, told which cell is being edited
+    std::function<void(int)> onBeginEdit = [](int) {};
+    std::function<void(int)> onEndEdit = [](int) {};
+    std::function<void(int)> onWheelEditOccurred = [](int) {};
+    std::function<void(int, const juce::ModifierKeys &)> onPopupMenu =
+        [](int, const juce::ModifierKeys &) {};
+
+    void paint(juce::Graphics &g) override;
+
+    void mouseDown(const juce::MouseEvent &e) override;
+    void mouseUp(const juce::MouseEvent &e) override;
+    void mouseDrag(const juce::MouseEvent &e) override;
+    void mouseDoubleClick(const juce::MouseEvent &e) override;
+    void mouseWheelMove(const juce::MouseEvent &e, const juce::MouseWheelDetails &wheel) override;
+    void mouseMove(const juce::MouseEvent &e) override;
+    void mouseExit(const juce::MouseEvent &e) override;
+
+    // Called by the focused cell's accessibility proxy
+    bool keyPressedOnCell(int index, const juce::KeyPress &k);
+    void setHoveredCell(int index);
+    int getHoveredCell() const { return hoveredCell; }
+
+    void setCellValueFromGUI(int index, float value);
+    void notifyAccessibleChange(int index);
+
+    /*
+     * Coalesces drag and wheel writes as EditableComponentBase::setValueEmissionRateHz
+     * does, for every cell. Only one cell is edited at a time, so the bank holds at most
+     * one write and one open wheel edit.
+     */
+    void setValueEmissionRateHz(int hz);
+    bool isCoalescingValueEmission() const { return valueEmissionRateHz > 0; }
+
+    // Start and finish an edit of a cell, closing any open wheel edit and sending any held
+    // write first
+    void beginEdit(int index);
+    void endEdit(int index);
+
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+  protected:
+    bool processMouseActions(int index);
+
+    void beginWheelEdit(int index);
+    void endWheelEdit(int index);
+    void emitValueWrite(int index, float value, bool quantized);
+    void flushValueWrite();
+    void dropValueWrite(int index);
+    void endWheelEditIfHidden();
+    // The value of the cell's edit, including a write still held
+    float getEditedValue(int index);
+
+    struct ValueEmissionTimer : juce::Timer
+    {
+        explicit ValueEmissionTimer(ParameterBank &b) : bank(b) {}
+        void timerCallback() override;
+        ParameterBank &bank;
+    };
+
+    int valueEmissionRateHz{0};
+    int wheelEditCell{-1}, pendingWriteCell{-1};
+    float heldValue{0};
+    std::function<void()> pendingValueWrite;
+    std::unique_ptr<ValueEmissionTimer> valueEmissionTimer;
+    // Made with the first held wheel edit, so hiding a parent ends one too
+    std::unique_ptr<util::VisibilityParentWatcher> wheelEditVisibilityWatcher;
+
+    std::vector<std::unique_ptr<Cell>> cells;
+    std::vector<std::unique_ptr<juce::Component>> accessibleCells;
+
+    int hoveredCell{-1}, dragCell{-1};
+    float mouseDownV0{0}, mouseDownX0{0}, mouseDownY0{0};
+
+    enum MouseMode
+    {
+        NONE,
+        POPUP,
+        DRAG
+    } mouseMode{NONE};
+
+    template <typename S>
+    int addCellFor(CellKind kind, S *source, const juce::Rectangle<int> &bounds);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterBank)
+};
+} // namespace sst::jucegui::components
+
+#endif // INCLUDE_SST_JUCEGUI_COMPONENTS_PARAMETERBANK_H
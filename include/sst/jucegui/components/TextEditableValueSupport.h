@@ -218,7 +218,7 @@ template <typename T> struct TextEditableValueSupport
             return;
 
         if (everDragged)
-            that->onEndEdit();
+            that->endEdit();
         else
             activateEditor();
     }
@@ -228,7 +228,7 @@ template <typename T> struct TextEditableValueSupport
         if (e.mods.isPopupMenu() && that->onPopupMenu)
             return false;
         if (!everDragged)
-            that->onBeginEdit();
+            that->beginEdit();
         everDragged = true;
         return true;
     }
@@ -41,6 +41,7 @@ struct VSlider : public ContinuousParamEditor, public style::StyleConsumer
     ~VSlider();
 
     void paint(juce::Graphics &g) override;
+    juce::Rectangle<int> getValueBounds() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VSlider)
 };
@@ -19,9 +19,15 @@
 #define INCLUDE_SST_JUCEGUI_COMPONENTS_VUMETER_H
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
 #include <string>
+#include <utility>
 #include <sst/jucegui/style/StyleAndSettingsConsumer.h>
 #include <sst/jucegui/style/StyleSheet.h>
+#include <sst/jucegui/components/BaseStyles.h>
 
 namespace sst::jucegui::components
 {
@@ -54,23 +60,85 @@ struct VUMeter : public juce::Component, public style::StyleConsumer, public sty
     };
 
     VUMeter(Direction d = VERTICAL) : style::StyleConsumer(Styles::styleClass), direction(d) {}
+    ~VUMeter();
 
+    /*
+     * The levels shown. setLevels is for message thread callers and shows exactly what it
+     * is given; audio thread callers should use a LevelFeed instead. Either way we only
+     * repaint when a level moves the meter by at least a pixel.
+     */
     float L{0}, R{0};
-    void setLevels(float iL, float iR)
+    void setLevels(float iL, float iR);
+
+    /*
+     * A lock free mailbox of block peaks, written by the audio thread and read by the
+     * meter on a refresh clock shared by every fed meter. pushLevels folds a block into
+     * the running maximum, so no peak between refreshes is lost, and the meter takes and
+     * clears that maximum on each tick. Hold the shared_ptr on the audio side so the feed
+     * outlives the meter if it has to.
+     */
+    struct LevelFeed
+    {
+        void pushLevels(float l, float r)
+        {
+            foldMax(peakL, l);
+            foldMax(peakR, r);
+        }
+        std::pair<float, float> takeLevels()
+        {
+            return {peakL.exchange(0.f, std::memory_order_acq_rel),
+                    peakR.exchange(0.f, std::memory_order_acq_rel)};
+        }
+
+      private:
+        static void foldMax(std::atomic<float> &a, float v)
+        {
+            auto cur = a.load(std::memory_order_relaxed);
+            while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_release,
+                                                       std::memory_order_relaxed))
+            {
+            }
+        }
+        std::atomic<float> peakL{0.f}, peakR{0.f};
+        static_assert(std::atomic<float>::is_always_lock_free);
+    };
+
+    // The feed for this meter, made (and the meter put on the refresh clock) on first use
+    std::shared_ptr<LevelFeed> getLevelFeed();
+
+    /*
+     * How fed levels move the meter. A rise shows at once; a fall waits out the peak hold
+     * and then drops at the release rate, never below the incoming level.
+     */
+    struct Ballistics
     {
-        L = iL;
-        R = iR;
-        repaint();
+        float peakHoldMs{0.f};
+        float releaseDbPerSecond{20.f};
+    };
+    void setBallistics(const Ballistics &b) { ballistics = b; }
+    const Ballistics &getBallistics() const { return ballistics; }
+
+    // The rate fed meters refresh at, capped by the maxRepaintHz setting
+    void setRefreshRateHz(float hz);
+    float getRefreshRateHz();
+
+    void onSettingChanged(style::Settings::KeyIndex k) override;
+    // The fraction of the meter a level fills
+    static float levelToFraction(float x)
+    {
+        x = std::clamp(0.5f * x, 0.f, 1.f);
+        return powf(x, 0.3333333333f);
     }
+
     void paint(juce::Graphics &g)
     {
+        paintedPixelL = levelToPixel(L);
+        paintedPixelR = levelToPixel(R);
+
         if (direction == VERTICAL)
         {
             float zerodb = (0.7937 * getHeight());
-            auto scale = [](float x) {
-                x = std::clamp(0.5f * x, 0.f, 1.f);
-                return powf(x, 0.3333333333f);
-            };
+            auto scale = levelToFraction;
 
             auto vl = getHeight() - scale(L) * getHeight();
             auto vr = getHeight() - scale(R) * getHeight();
@@ -130,10 +198,7 @@ struct VUMeter : public juce::Component, public style::StyleConsumer, public sty
         else
         {
             float zerodb = (0.7937 * getWidth());
-            auto scale = [](float x) {
-                x = std::clamp(0.5f * x, 0.f, 1.f);
-                return powf(x, 0.3333333333f);
-            };
+            auto scale = levelToFraction;
 
             auto vl = scale(L) * getWidth();
             auto vr = scale(R) * getWidth();
@@ -180,6 +245,25 @@ struct VUMeter : public juce::Component, public style::StyleConsumer, public sty
             g.drawRect(rRight, 1);
         }
     }
+
+    // Called by the shared refresh clock
+    void refreshFromFeed(double nowMs);
+
+  protected:
+    int levelToPixel(float x) const
+    {
+        auto extent = direction == VERTICAL ? getHeight() : getWidth();
+        return juce::roundToInt(levelToFraction(x) * extent);
+    }
+    // Show these levels, repainting only if either moved a pixel since the last paint
+    void updateLevels(float iL, float iR);
+
+    int paintedPixelL{-1}, paintedPixelR{-1};
+
+    std::shared_ptr<LevelFeed> feed;
+    Ballistics ballistics;
+    float refreshRateHz{60.f};
+    double lastRefreshMs{0}, holdUntilMsL{0}, holdUntilMsR{0};
 };
 } // namespace sst::jucegui::components
 #endif // CONDUIT_VUMETER_H
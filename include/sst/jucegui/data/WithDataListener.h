@@ -30,6 +30,9 @@ template <typename T> struct WithDataListener
         virtual ~DataListener() = default;
         // FIXME - in the future we may want this more fine grained
         virtual void dataChanged() = 0;
+        // Only the value changed. Sources which know that can say so, and listeners which
+        // can repaint less for it may; by default it is just another change.
+        virtual void valueChanged() { dataChanged(); }
         virtual void sourceVanished(T *) = 0;
     };
     bool supressListenerModification{false};
@@ -67,7 +67,9 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
     std::vector<ColorEntry> entries;
 
     // Optional extra callback fired after every colour update (any entry, including
-    // live slider drags). Use this to repaint a parent component in real time.
+    // live slider drags). Editors made by forStyleKeys / forColorMap need no help here,
+    // since the stylesheet repaints the consumers of the classes it changed; use this
+    // for anything else which should follow the edit in real time.
     std::function<void()> onAnyColorChanged;
 
     // -------------------------------------------------------------------------
@@ -83,6 +85,8 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
 
     ~ColorEditor()
     {
+        // land a picker drag which hasn't reached a frame yet, as openPickerFor does
+        flushPendingPickerColour();
         if (activePicker)
             activePicker->removeChangeListener(this);
     }
@@ -134,7 +138,9 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
             }
         };
 
-        return std::make_unique<ColorEditor>(std::move(ents), std::move(cb), includeAlpha);
+        auto res = std::make_unique<ColorEditor>(std::move(ents), std::move(cb), includeAlpha);
+        res->editedSheet = stylesheet;
+        return res;
     }
 
     // -------------------------------------------------------------------------
@@ -166,7 +172,9 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
             }
         };
 
-        return std::make_unique<ColorEditor>(std::move(ents), std::move(cb), includeAlpha);
+        auto res = std::make_unique<ColorEditor>(std::move(ents), std::move(cb), includeAlpha);
+        res->editedSheet = stylesheet;
+        return res;
     }
 
   private:
@@ -187,6 +195,13 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
     int activePickerIdx{-1};
     juce::Component::SafePointer<juce::ColourSelector> activePicker;
 
+    // When made by a factory, each edit is one stylesheet batch (one consumer refresh)
+    style::StyleSheet::ptr_t editedSheet;
+
+    // Picker drags arrive faster than we can draw; keep the latest and apply it per frame
+    std::optional<juce::Colour> pendingPickerColour;
+    juce::VBlankAttachment pickerVBlank{this, [this]() { flushPendingPickerColour(); }};
+
     // -------------------------------------------------------------------------
     // ChangeListener callback — receives colour changes from juce::ColourSelector
     // -------------------------------------------------------------------------
@@ -196,7 +211,17 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
             return;
         if (activePickerIdx < 0 || activePickerIdx >= (int)entries.size())
             return;
-        updateEntry(activePickerIdx, activePicker->getCurrentColour());
+        pendingPickerColour = activePicker->getCurrentColour();
+    }
+
+    void flushPendingPickerColour()
+    {
+        if (!pendingPickerColour.has_value())
+            return;
+        auto c = *pendingPickerColour;
+        pendingPickerColour.reset();
+        if (activePickerIdx >= 0 && activePickerIdx < (int)entries.size())
+            updateEntry(activePickerIdx, c);
     }
 
     // -------------------------------------------------------------------------
@@ -247,9 +272,11 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
         if (idx < 0 || idx >= (int)entries.size())
             return;
 
-        // Remove listener from any existing picker before launching a new one
+        // Remove listener from any existing picker before launching a new one, landing
+        // whatever it still had in flight on the entry it was editing
         if (activePicker)
             activePicker->removeChangeListener(this);
+        flushPendingPickerColour();
 
         activePickerIdx = idx;
 
@@ -271,9 +298,14 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
     void updateEntry(int idx, juce::Colour c)
     {
         entries[idx].color = c;
-        onColorChanged(entries[idx].tag, c);
-        if (onAnyColorChanged)
-            onAnyColorChanged();
+        {
+            std::optional<style::StyleSheet::Batch> batch;
+            if (editedSheet)
+                batch.emplace(*editedSheet);
+            onColorChanged(entries[idx].tag, c);
+            if (onAnyColorChanged)
+                onAnyColorChanged();
+        }
         listView->refresh(true);
     }
 
@@ -383,20 +415,13 @@ struct ColorEditor : components::NamedPanel, private juce::ChangeListener
         void parentHierarchyChanged() override
         {
             // RowComponents are created lazily by ListView and inserted into the tree
-            // *after* setStyle has already propagated from the ColorEditor. Walk up to
-            // the nearest StyleConsumer ancestor and push the stylesheet down to our
-            // styled children so they pick up the theme colours.
-            for (auto *p = getParentComponent(); p; p = p->getParentComponent())
+            // *after* setStyle has already propagated from the ColorEditor. Push the
+            // nearest styled ancestor's sheet down to our styled children so they pick
+            // up the theme colours.
+            if (auto s = style::StyleConsumer::styleForComponentOrAncestors(getParentComponent()))
             {
-                if (auto *sc = dynamic_cast<style::StyleConsumer *>(p))
-                {
-                    if (auto s = sc->style())
-                    {
-                        nameLabel->setStyle(s);
-                        hexField->setStyle(s);
-                        return;
-                    }
-                }
+                nameLabel->setStyle(s);
+                hexField->setStyle(s);
             }
         }
 
@@ -420,11 +445,34 @@ struct ColorEditorModal : ModalBase
 {
     ColorEditorModal(std::vector<ColorEditor::ColorEntry> ents,
                      ColorEditor::ColorChangedFn callback, bool includeAlpha = false)
+        : ColorEditorModal(
+              std::make_unique<ColorEditor>(std::move(ents), std::move(callback), includeAlpha))
+    {
+    }
+
+    // Host an editor from ColorEditor::forStyleKeys / forColorMap, which batches its
+    // stylesheet edits
+    explicit ColorEditorModal(std::unique_ptr<ColorEditor> ed) : editor(std::move(ed))
     {
-        editor = std::make_unique<ColorEditor>(std::move(ents), std::move(callback), includeAlpha);
         addAndMakeVisible(*editor);
     }
 
+    static std::unique_ptr<ColorEditorModal> forStyleKeys(style::StyleSheet::ptr_t stylesheet,
+                                                          std::vector<ColorEditor::StyleKey> keys,
+                                                          bool includeAlpha = false)
+    {
+        return std::make_unique<ColorEditorModal>(
+            ColorEditor::forStyleKeys(std::move(stylesheet), std::move(keys), includeAlpha));
+    }
+
+    static std::unique_ptr<ColorEditorModal>
+    forColorMap(style::StyleSheet::ptr_t stylesheet,
+                std::vector<ColorEditor::ColorMapEntry> colorMap, bool includeAlpha = false)
+    {
+        return std::make_unique<ColorEditorModal>(
+            ColorEditor::forColorMap(std::move(stylesheet), std::move(colorMap), includeAlpha));
+    }
+
     juce::Point<int> innerContentSize() override { return {500, 480}; }
 
     void resized() override
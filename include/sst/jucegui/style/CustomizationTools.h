@@ -66,15 +66,16 @@ struct CustomTypeMap
 
     void applyMapTo(juce::Component *c)
     {
-        Traverser t;
-        t.forStyleParticpants(c, [this](auto *target) {
+        for (auto &e : ConsumerRoster::forRoot(c).entries())
+        {
+            if (!e.style || !e.component)
+                continue;
             for (auto &m : remappers)
             {
-                if (m(target))
+                if (m(e.style))
                     break;
             }
-            return true;
-        });
+        }
     }
 };
 } // namespace sst::jucegui::style
@@ -19,21 +19,116 @@
 #define INCLUDE_SST_JUCEGUI_STYLE_SETTINGS_H
 
 #include <memory>
+#include <array>
+#include <optional>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
 
 namespace sst::jucegui::style
 {
+struct SettingsConsumer;
 
 /**
  * The Settings object contains a set of methods to answer user preferences in the
  * UI. To consume this, you should implement `style::SettingsConsumer`
+ *
+ * Preferences are typed keys. A Settings object answers a key from its own value, then
+ * from its parent's, and finally from the key's default, so an application can keep one
+ * settings object and specialise parts of the UI with children. Consumers without
+ * settings of their own share getDefault() rather than each allocating one.
+ *
+ * Lookups are cached and only re-resolved after some settings object changes. Consumers
+ * subscribe to the keys they care about and get onSettingChanged for those keys only, when
+ * the change reaches the settings object they read from.
  */
 struct Settings
 {
-    virtual ~Settings() = default;
+    enum KeyIndex
+    {
+        HIDE_MOUSE_ON_DRAG,
+        DRAG_SENSITIVITY,
+        WHEEL_SCALING,
+        MAX_REPAINT_HZ,
+
+        numKeys
+    };
+
+    template <typename T> struct Key
+    {
+        KeyIndex index;
+        T defaultValue;
+        const char *name;
+    };
+
+    // Multiplies mouse drag deltas on continuous and discrete editors
+    static constexpr Key<float> dragSensitivity{DRAG_SENSITIVITY, 1.f, "dragSensitivity"};
+    // Multiplies mouse wheel deltas
+    static constexpr Key<float> wheelScaling{WHEEL_SCALING, 1.f, "wheelScaling"};
+    static constexpr Key<bool> hideMouseOnDrag{HIDE_MOUSE_ON_DRAG, true, "hideMouseOnDrag"};
+    // An upper bound for components which repaint on a clock (meters and so on); 0 is none
+    static constexpr Key<float> maxRepaintHz{MAX_REPAINT_HZ, 60.f, "maxRepaintHz"};
 
-    virtual bool hideMouse() { return true; }
+    Settings() = default;
+    explicit Settings(const std::shared_ptr<Settings> &p) { setParent(p); }
+    virtual ~Settings();
+
+    Settings(const Settings &) = delete;
+    Settings &operator=(const Settings &) = delete;
 
     typedef std::shared_ptr<Settings> ptr_t;
+
+    // One process wide default, used by any consumer with no settings of its own
+    static const ptr_t &getDefault();
+
+    void setParent(const ptr_t &p);
+    const ptr_t &getParent() const { return parent; }
+
+    template <typename T> T get(const Key<T> &k) const
+    {
+        if (resolvedGeneration != lastGeneration)
+            resolveAll();
+        return (T)resolved[k.index];
+    }
+
+    template <typename T> void set(const Key<T> &k, T value)
+    {
+        setRaw(k.index, (double)value);
+    }
+
+    // Drop our value so the key follows the parent (or the default) again
+    template <typename T> void clear(const Key<T> &k) { setRaw(k.index, std::nullopt); }
+
+    template <typename T> bool isSetHere(const Key<T> &k) const
+    {
+        return values[k.index].has_value();
+    }
+
+    // Consumers who subscribed to the key through this object
+    size_t getSubscriberCount(KeyIndex k) const { return subscribers[k].size(); }
+
+    virtual bool hideMouse() { return get(hideMouseOnDrag); }
+
+  private:
+    friend struct SettingsConsumer;
+
+    void setRaw(KeyIndex k, std::optional<double> v);
+    void resolveAll() const;
+    void notifyKeyChanged(KeyIndex k);
+
+    void subscribe(KeyIndex k, SettingsConsumer *sc) { subscribers[k].insert(sc); }
+    void unsubscribe(KeyIndex k, SettingsConsumer *sc) { subscribers[k].erase(sc); }
+
+    std::array<std::optional<double>, numKeys> values{};
+    mutable std::array<double, numKeys> resolved{};
+    mutable uint64_t resolvedGeneration{0};
+
+    // Any change anywhere may alter what a child resolves, so all caches key off this
+    static uint64_t lastGeneration;
+
+    ptr_t parent;
+    std::vector<Settings *> children;
+    std::array<std::unordered_set<SettingsConsumer *>, numKeys> subscribers;
 };
 } // namespace sst::jucegui::style
 
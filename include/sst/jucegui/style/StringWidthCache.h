@@ -0,0 +1,57 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#ifndef INCLUDE_SST_JUCEGUI_STYLE_STRINGWIDTHCACHE_H
+#define INCLUDE_SST_JUCEGUI_STYLE_STRINGWIDTHCACHE_H
+
+#include <cstdint>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace sst::jucegui::style
+{
+struct FontHandle;
+
+/**
+ * Labels, panel headers and tooltips measure the same few strings on every paint or
+ * resize, and text shaping is expensive. This is a bounded, process wide LRU of measured
+ * widths, keyed by (font, string). A FontHandle keys by its id; a bare juce::Font keys
+ * by its description (typeface, style, height, kerning and scale). A changed font gets a
+ * new handle id or description, so entries never go stale and changing fonts needn't
+ * clear this; old entries just age out. SST_STRING_WIDTH_INT and SST_STRING_WIDTH_FLOAT
+ * route through here.
+ */
+struct StringWidthCache
+{
+    static constexpr size_t maxEntries{4096};
+
+    static float getStringWidth(const juce::Font &f, const juce::String &s);
+    static float getStringWidth(const FontHandle &f, const juce::String &s);
+    static int getStringWidthInt(const juce::Font &f, const juce::String &s)
+    {
+        return juce::roundToInt(getStringWidth(f, s));
+    }
+    static int getStringWidthInt(const FontHandle &f, const juce::String &s)
+    {
+        return juce::roundToInt(getStringWidth(f, s));
+    }
+
+    static void clear();
+    static size_t size();
+};
+} // namespace sst::jucegui::style
+
+#endif // INCLUDE_SST_JUCEGUI_STYLE_STRINGWIDTHCACHE_H
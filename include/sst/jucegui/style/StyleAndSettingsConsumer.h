@@ -20,6 +20,8 @@
 
 #include <string>
 #include <vector>
+#include <array>
+#include <unordered_set>
 #include "StyleSheet.h"
 #include "Settings.h"
 
@@ -32,82 +34,92 @@ namespace sst::jucegui::style
 struct StyleConsumer
 {
     explicit StyleConsumer(const StyleSheet::Class &c) : styleClass(c) {}
-    virtual ~StyleConsumer() { stylep = nullptr; };
+    virtual ~StyleConsumer();
 
     juce::Colour getColour(const StyleSheet::Property &p)
     {
-        if (style())
-            return style()->getColour(getStyleClass(), p);
-        return juce::Colours::red;
+        auto *s = resolveStyle();
+        if (!s)
+            return juce::Colours::red;
+
+        validateResolvedCache(s);
+        auto pid = StyleSheet::propertyIdFor(p);
+        auto &e = resolvedCache.colours[(size_t)pid % ResolvedCache::colourSlots];
+        if (e.propertyId != pid)
+        {
+            e.value = s->getColour(getStyleClass(), p);
+            e.propertyId = pid;
+        }
+        return e.value;
     }
 
-    juce::Font getFont(const StyleSheet::Property &p)
+    juce::Font getFont(const StyleSheet::Property &p) { return getFontHandle(p)->font; }
+
+    /*
+     * The font and its cached metrics. Handles are immutable and shared, so hold on to the
+     * returned pointer for as long as you like; a sheet font change makes new handles
+     * rather than touching this one.
+     */
+    FontHandle::ptr_t getFontHandle(const StyleSheet::Property &p)
     {
-        if (style())
-            return style()->getFont(getStyleClass(), p);
-        return SST_JUCE_FONT_CTOR(1);
+        auto *s = resolveStyle();
+        if (!s)
+        {
+            static const FontHandle::ptr_t unstyled =
+                std::make_shared<const FontHandle>(SST_JUCE_FONT_CTOR(1));
+            return unstyled;
+        }
+
+        validateResolvedCache(s);
+        auto pid = StyleSheet::propertyIdFor(p);
+        auto &e = resolvedCache.fonts[(size_t)pid % ResolvedCache::fontSlots];
+        if (e.propertyId != pid)
+        {
+            e.value = s->getFontHandle(getStyleClass(), p);
+            e.propertyId = pid;
+        }
+        return e.value;
     }
 
-    // these don't belong on instances they belong on stylesheets
-    StyleSheet::Class customClass{""};
+    // these don't belong on instances they belong on stylesheets. Like the style class
+    // itself, the custom class is a reference to a long lived constexpr declaration.
+    const StyleSheet::Class *customClass{nullptr};
     void setCustomClass(const StyleSheet::Class &sc)
     {
-        customClass.copyFrom(sc);
+        customClass = &sc;
+        reattachStyle();
         onStyleChanged();
     }
 
-    void removeCustomClass() { customClass.cname[0] = 0; }
+    void removeCustomClass()
+    {
+        customClass = nullptr;
+        reattachStyle();
+    }
 
     const StyleSheet::Class &getStyleClass()
     {
-        if (customClass.cname[0] != 0)
-            return customClass;
+        if (customClass)
+            return *customClass;
         return styleClass;
     }
 
     void setStyle(const StyleSheet::ptr_t &s);
     void notifyOnStyleChanged();
 
+    /*
+     * The sheet of the nearest styled consumer at or above c, or nullptr. Consumers with a
+     * sheet register their component, so this walk is a hash lookup per level rather than
+     * a dynamic_cast.
+     */
+    static StyleSheet::ptr_t styleForComponentOrAncestors(juce::Component *c);
+
     /*
      * Note style() can return nullptr
      */
     inline StyleSheet::ptr_t style()
     {
-        if (!stylep)
-        {
-            auto jc = dynamic_cast<juce::Component *>(this);
-            while (jc)
-            {
-                jc = jc->getParentComponent();
-                auto sc = dynamic_cast<StyleConsumer *>(jc);
-                if (sc)
-                {
-                    stylep = sc->style();
-                    if (stylep)
-                    {
-                        onStyleChanged();
-                        jc = nullptr;
-                    }
-                }
-            }
-            /* Please ask BP before you nuke this debug code
-            if (!stylep)
-            {
-                std::cout << "Style Unresolved" << std::endl;
-
-                jc = dynamic_cast<juce::Component *>(this);
-                std::string pfx = "";
-                while (jc)
-                {
-                    std::cout << pfx << jc << " " << jc->getTitle() << " "
-                              << jc->getBounds().toString() << " " << typeid(*jc).name() << " "
-                              << dynamic_cast<StyleConsumer *>(jc) << "\n";
-                    pfx = pfx + "   ";
-                    jc = jc->getParentComponent();
-                }
-            }
-             */
-        }
+        resolveStyle();
         return stylep;
     }
     virtual void onStyleChanged() {}
@@ -115,6 +127,95 @@ struct StyleConsumer
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StyleConsumer)
 
   private:
+    friend struct StyleSheet;
+
+    // Swap the sheet we hold, moving our registrations with it
+    void adoptStyle(const StyleSheet::ptr_t &s);
+
+    // Our class changed, so move to the right bucket in the sheet
+    void reattachStyle()
+    {
+        if (attachedSheet)
+        {
+            attachedSheet->detachConsumer(this);
+            stylep->attachConsumer(this);
+        }
+    }
+
+    StyleSheet *attachedSheet{nullptr};
+    int attachedClassId{-1};
+    size_t attachedIndex{0};
+
+    /*
+     * Find (and adopt) the stylesheet, returning it without touching the shared_ptr
+     * refcount so the per-paint getters stay cheap. A consumer with no sheet of its own
+     * looks up its nearest styled ancestor once; a hierarchy listener on our component
+     * marks an inherited sheet stale when we (or an ancestor) are reparented, so the
+     * next lookup resolves again.
+     */
+    inline StyleSheet *resolveStyle()
+    {
+        if (!stylep || inheritedStyleStale)
+            resolveFromAncestors();
+        return stylep.get();
+    }
+    void resolveFromAncestors();
+    void applyStyle(const StyleSheet::ptr_t &s, bool inherited);
+
+    // The component this consumer is mixed into, found with a single dynamic_cast
+    juce::Component *styledComponent();
+
+    struct HierarchyListener : juce::ComponentListener
+    {
+        explicit HierarchyListener(StyleConsumer &o) : owner(o) {}
+        void componentParentHierarchyChanged(juce::Component &) override;
+        void componentBeingDeleted(juce::Component &) override;
+        StyleConsumer &owner;
+    } hierarchyListener{*this};
+
+    juce::Component *component{nullptr};
+    bool componentResolved{false};
+    bool styleInherited{false}, inheritedStyleStale{false};
+
+    /*
+     * A small direct mapped cache of the values this consumer reads on repaint. It is
+     * valid while the sheet, its generation, the inheritance epoch and our class are
+     * unchanged; anything else drops every entry.
+     */
+    struct ResolvedCache
+    {
+        static constexpr size_t colourSlots{8}, fontSlots{2};
+        template <typename T> struct Entry
+        {
+            int propertyId{-1};
+            T value;
+        };
+        std::array<Entry<juce::Colour>, colourSlots> colours;
+        std::array<Entry<FontHandle::ptr_t>, fontSlots> fonts;
+
+        const StyleSheet *sheet{nullptr};
+        uint64_t generation{0}, inheritanceEpoch{0};
+        int classId{-1};
+    } resolvedCache;
+
+    void validateResolvedCache(const StyleSheet *s)
+    {
+        auto cid = StyleSheet::classIdFor(getStyleClass());
+        auto &rc = resolvedCache;
+        if (rc.sheet == s && rc.generation == s->getGeneration() &&
+            rc.inheritanceEpoch == StyleSheet::inheritanceEpoch && rc.classId == cid)
+            return;
+
+        for (auto &e : rc.colours)
+            e.propertyId = -1;
+        for (auto &e : rc.fonts)
+            e.propertyId = -1;
+        rc.sheet = s;
+        rc.generation = s->getGeneration();
+        rc.inheritanceEpoch = StyleSheet::inheritanceEpoch;
+        rc.classId = cid;
+    }
+
     StyleSheet::ptr_t stylep;
     const StyleSheet::Class &styleClass;
 };
@@ -122,21 +223,88 @@ struct StyleConsumer
 struct SettingsConsumer
 {
     SettingsConsumer() = default;
-    virtual ~SettingsConsumer() = default;
+    virtual ~SettingsConsumer();
 
     void setSettings(const Settings::ptr_t &s);
-    inline Settings::ptr_t settings()
+
+    /*
+     * Our settings, or the process wide Settings::getDefault() if none were set; never
+     * null. That default is shared by every consumer without settings of its own, so a
+     * settings()->set() made before setSettings changes all of them. To change just this
+     * consumer, give it its own settings (perhaps parented to the default) first.
+     */
+    inline const Settings::ptr_t &settings()
+    {
+        return settingsp ? settingsp : Settings::getDefault();
+    }
+    template <typename T> T getSetting(const Settings::Key<T> &k) { return settings()->get(k); }
+
+    /*
+     * Ask for onSettingChanged when this key changes in the settings we read from (or
+     * in one of its parents, if it isn't overridden on the way down). Subscriptions
+     * follow the consumer through setSettings.
+     */
+    template <typename T> void subscribeToSetting(const Settings::Key<T> &k)
     {
-        if (!settingsp)
-            settingsp = std::make_shared<Settings>();
-        return settingsp;
+        auto bit = 1u << k.index;
+        if (subscribedKeys & bit)
+            return;
+        subscribedKeys |= bit;
+        settings()->subscribe(k.index, this);
     }
+
     virtual void onSettingsChanged() {}
+    virtual void onSettingChanged(Settings::KeyIndex k) {}
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SettingsConsumer)
 
   private:
+    // Swap the settings we hold, moving our subscriptions with them
+    void adoptSettings(const Settings::ptr_t &s);
+
     Settings::ptr_t settingsp;
+    uint32_t subscribedKeys{0};
+};
+
+/*
+ * The style and settings consumers at and below a root component, as a flat pre-order
+ * array built with a single traversal (and so a single dynamic_cast per component).
+ * The roster listens to every component in the subtree, so adding or removing a child
+ * anywhere below the root marks it dirty and the next use rebuilds it. setStyle,
+ * setSettings and CustomTypeMap::applyMapTo walk this array rather than recursing, so
+ * re-theming an unchanged tree is one linear pass with one repaint.
+ *
+ * Rosters are owned by a registry keyed by root and go away with their root. They are
+ * message thread only.
+ */
+struct ConsumerRoster : private juce::ComponentListener
+{
+    struct Entry
+    {
+        juce::Component::SafePointer<juce::Component> component;
+        StyleConsumer *style{nullptr};
+        SettingsConsumer *settings{nullptr};
+    };
+
+    static ConsumerRoster &forRoot(juce::Component *root);
+
+    // Entry 0 is the root itself; entries may die while a caller iterates, so check them
+    const std::vector<Entry> &entries();
+    bool isDirty() const { return dirty; }
+
+    ~ConsumerRoster() override;
+
+  private:
+    explicit ConsumerRoster(juce::Component *r) : root(r) {}
+    void rebuild();
+    void unwatchAll();
+    void componentChildrenChanged(juce::Component &) override { dirty = true; }
+    void componentBeingDeleted(juce::Component &c) override;
+
+    juce::Component *root{nullptr};
+    std::vector<Entry> list;
+    std::unordered_set<juce::Component *> watched;
+    bool dirty{true};
 };
 } // namespace sst::jucegui::style
 
@@ -21,8 +21,16 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
+#include <optional>
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <cstdint>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <cassert>
+#include "StringWidthCache.h"
 
 #if JUCE_VERSION >= 0x080000
 #define SST_JUCE_FONT_CTOR(...) juce::Font(juce::FontOptions(__VA_ARGS__))
@@ -30,19 +38,71 @@
 #define SST_JUCE_FONT_CTOR(...) juce::Font(__VA_ARGS__)
 #endif
 
+// Lookup profiling is compiled out unless the SST_JUCEGUI_STYLE_PROFILING cmake option is on
+#ifndef SST_JUCEGUI_STYLE_PROFILING
+#define SST_JUCEGUI_STYLE_PROFILING 0
+#endif
+
 // Yes, a non-compatible point release! Fun eh?
 #if JUCE_VERSION >= 0x080002
-#define SST_STRING_WIDTH_INT(a, b) juce::GlyphArrangement::getStringWidthInt(a, b)
-#define SST_STRING_WIDTH_FLOAT(a, b) juce::GlyphArrangement::getStringWidth(a, b)
+#define SST_STRING_WIDTH_FLOAT_UNCACHED(a, b) juce::GlyphArrangement::getStringWidth(a, b)
 #else
-#define SST_STRING_WIDTH_INT(a, b) a.getStringWidth(b)
-#define SST_STRING_WIDTH_FLOAT(a, b) a.getStringWidthFloat(b)
+#define SST_STRING_WIDTH_FLOAT_UNCACHED(a, b) a.getStringWidthFloat(b)
 #endif
 
+// Measurement is memoized; `a` may be a juce::Font or a style::FontHandle
+#define SST_STRING_WIDTH_INT(a, b) sst::jucegui::style::StringWidthCache::getStringWidthInt(a, b)
+#define SST_STRING_WIDTH_FLOAT(a, b) sst::jucegui::style::StringWidthCache::getStringWidth(a, b)
+
 namespace sst::jucegui::style
 {
 struct StyleConsumer;
 
+/**
+ * A FontHandle is an immutable, shared snapshot of a stylesheet font along with the
+ * metrics widgets keep asking for. A sheet hands out the same handle for a font until
+ * that font changes, so holding one across paints is cheap and its id is a stable
+ * cache key. Glyph advances for the ASCII range are measured once per handle on demand.
+ */
+struct FontHandle
+{
+    explicit FontHandle(const juce::Font &f)
+        : font(f), height(f.getHeight()), ascent(f.getAscent()), descent(f.getDescent()),
+          id(lastId.fetch_add(1, std::memory_order_relaxed) + 1)
+    {
+        for (auto &a : asciiAdvances)
+            a.store(-1.f, std::memory_order_relaxed);
+    }
+
+    const juce::Font font;
+    const float height, ascent, descent;
+    const uint64_t id;
+
+    float getGlyphAdvance(juce::juce_wchar c) const
+    {
+        if (c >= 0 && (size_t)c < asciiAdvances.size())
+        {
+            auto &a = asciiAdvances[(size_t)c];
+            auto v = a.load(std::memory_order_relaxed);
+            if (v < 0)
+            {
+                v = SST_STRING_WIDTH_FLOAT_UNCACHED(font, juce::String::charToString(c));
+                a.store(v, std::memory_order_relaxed);
+            }
+            return v;
+        }
+        return SST_STRING_WIDTH_FLOAT_UNCACHED(font, juce::String::charToString(c));
+    }
+
+    typedef std::shared_ptr<const FontHandle> ptr_t;
+
+  private:
+    // atomic so handles shared with snapshots can be measured from any thread
+    mutable std::array<std::atomic<float>, 128> asciiAdvances;
+    // atomic as handles are made wherever a sheet is read, including off the message thread
+    static std::atomic<uint64_t> lastId;
+};
+
 /**
  * A StyleSheet is the class which allows us to get fonts, colors, and other properties
  * which we apply to widgets at render time. It relies on a few core features
@@ -73,26 +133,37 @@ struct StyleSheet
 
     static void initializeStyleSheets(std::function<void()> userClassInitializers);
 
+    /*
+     * Class and Property names hash at compile time. Both are small handles onto a
+     * string literal in static storage, declared constexpr by the SCLASS and PROP
+     * macros. The constructors are consteval so a name can never point at a temporary.
+     * hashName itself is also usable at runtime, for names read from a theme file.
+     */
+    static constexpr uint64_t hashName(std::string_view s)
+    {
+        uint64_t h{14695981039346656037ULL};
+        for (auto c : s)
+        {
+            h ^= (uint8_t)c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
     struct Class
     {
-        static constexpr int nameLength = 256;
-        char cname[nameLength]{0};
+        std::string_view name;
+        const char *cname; // the same literal as name; nul terminated
+        uint64_t hash;
 
-        static constexpr int maxProps = 4096;
-        int nProps{0};
+        /*
+         * The dense registry id for this class name. It is assigned by addClass (or
+         * lazily on first lookup) and indexes the flat value tables of a sheet.
+         */
+        mutable int id{-1};
 
-        constexpr Class(const char *s)
-        {
-            for (int i = 0; i < nameLength - 1; ++i)
-            {
-                cname[i] = s[i];
-                if (cname[i] == 0)
-                    break;
-            }
-            cname[nameLength - 1] = 0;
-        }
+        consteval Class(const char *s) : name(s), cname(s), hash(hashName(s)) {}
 
-        void copyFrom(const Class &other) { strncpy(cname, other.cname, nameLength); }
         Class(const Class &other) = delete;
         Class &operator=(const Class &) = delete;
         Class &operator=(Class &&) = delete;
@@ -100,23 +171,22 @@ struct StyleSheet
 
     struct Property
     {
-        static constexpr int nameLength = 256;
-        char pname[nameLength]{0};
+        std::string_view name;
+        const char *pname; // the same literal as name; nul terminated
+        uint64_t hash;
 
         enum Type
         {
             COLOUR,
             FONT
         } type;
-        constexpr Property(const char *s, Type t = COLOUR) : type(t)
+
+        // The dense registry id for this property name; see Class::id
+        mutable int id{-1};
+
+        consteval Property(const char *s, Type t = COLOUR)
+            : name(s), pname(s), hash(hashName(s)), type(t)
         {
-            for (int i = 0; i < nameLength - 1; ++i)
-            {
-                pname[i] = s[i];
-                if (pname[i] == 0)
-                    break;
-            }
-            pname[nameLength - 1] = 0;
         }
 
         Property(const Property &other) = delete;
@@ -146,26 +216,132 @@ struct StyleSheet
         inheritanceStructureParentTo;
     static bool isValidPair(const Class &c, const Property &p);
 
+    /*
+     * Every class and property name gets a small dense integer id the first time it is
+     * declared (or looked up). Two objects with the same name share an id, since the
+     * registry is keyed by the compile time name hash. The id is cached on the object so
+     * steady state lookups are an integer read and no string work.
+     */
+    static int classIdFor(const Class &c);
+    static int propertyIdFor(const Property &p);
+    static size_t registeredClassCount() { return classNamesById.size(); }
+    static size_t registeredPropertyCount() { return propertyNamesById.size(); }
+
+    static std::vector<std::string> classNamesById, propertyNamesById;
+    // classId -> base classIds in declaration order; the id mirror of inheritFromTo
+    static std::vector<std::vector<int>> inheritFromToById;
+    // classId -> classIds which directly list it as a base
+    static std::vector<std::vector<int>> derivedClassesById;
+    // bumped whenever the inheritance graph changes, so sheets can drop resolved lookups
+    static uint64_t inheritanceEpoch;
+
     virtual bool hasColour(const Class &c, const Property &p) const = 0;
     virtual juce::Colour getColour(const Class &c, const Property &p) const = 0;
     virtual std::optional<juce::Colour> getColourOptional(const Class &c,
                                                           const Property &p) const = 0;
-    virtual void setColour(const Class &c, const Property &p, const juce::Colour &) = 0;
+    void setColour(const Class &c, const Property &p, const juce::Colour &col)
+    {
+        doSetColour(c, p, col);
+        noteChanged(c, p);
+    }
 
     virtual bool hasFont(const Class &c, const Property &p) const = 0;
     virtual juce::Font getFont(const Class &c, const Property &p) const = 0;
     virtual std::optional<juce::Font> getFontOptional(const Class &c, const Property &p) const = 0;
-    virtual void setFont(const Class &c, const Property &p, const juce::Font &) = 0;
+    void setFont(const Class &c, const Property &p, const juce::Font &f)
+    {
+        doSetFont(c, p, f);
+        noteChanged(c, p);
+    }
 
-    virtual void replaceFontsWithTypeface(const juce::Typeface::Ptr &p) = 0;
-    virtual void replaceFontsWithFamily(const juce::String familyName) = 0;
+    /*
+     * The font for the pair as a shared handle with cached metrics. The built in sheets
+     * keep one handle per font and rebuild it only when that font changes; this default
+     * makes a fresh handle per call.
+     */
+    virtual FontHandle::ptr_t getFontHandle(const Class &c, const Property &p) const
+    {
+        return std::make_shared<const FontHandle>(getFont(c, p));
+    }
+
+    void replaceFontsWithTypeface(const juce::Typeface::Ptr &p)
+    {
+        doReplaceFontsWithTypeface(p);
+        noteEverythingChanged();
+    }
+    void replaceFontsWithFamily(const juce::String familyName)
+    {
+        doReplaceFontsWithFamily(familyName);
+        noteEverythingChanged();
+    }
 
     // Set every font's height to its baseline + `delta` (negative shrinks).
     // Idempotent: each font tracks the height it was last set to via setFont
     // as its baseline, so repeated calls do not compound. Preserves relative
     // size differences between fonts.
-    virtual void setFontHeightDelta(float delta) = 0;
-    virtual void setFontExtraKerningFactor(float fac) = 0;
+    void setFontHeightDelta(float delta)
+    {
+        fontHeightDelta = delta;
+        doSetFontHeightDelta(delta);
+        noteEverythingChanged();
+    }
+    void setFontExtraKerningFactor(float fac)
+    {
+        fontExtraKerningFactor = fac;
+        doSetFontExtraKerningFactor(fac);
+        noteEverythingChanged();
+    }
+
+    /**
+     * A Snapshot is an immutable, fully resolved copy of a sheet: every registered
+     * (class, property) pair already has inheritance applied. Snapshots are never
+     * mutated, so any number of threads can read one without locking, which lets
+     * panels and meters be pre-rendered off the message thread.
+     *
+     * Take snapshots on the message thread with StyleSheet::snapshot(), then hand them
+     * to the renderer. The sheet caches its latest snapshot until the next mutation,
+     * when the following snapshot() call builds a new one; existing holders keep the
+     * old one (copy on write). Lookups read only the ids classes and properties were
+     * given at registration and never touch the registry.
+     */
+    struct Snapshot
+    {
+        typedef std::shared_ptr<const Snapshot> ptr_t;
+
+        uint64_t getGeneration() const { return generation; }
+
+        bool hasColour(const Class &c, const Property &p) const;
+        juce::Colour getColour(const Class &c, const Property &p) const;
+        std::optional<juce::Colour> getColourOptional(const Class &c, const Property &p) const;
+
+        bool hasFont(const Class &c, const Property &p) const;
+        juce::Font getFont(const Class &c, const Property &p) const;
+        FontHandle::ptr_t getFontHandle(const Class &c, const Property &p) const;
+
+        int getSliderGutterWidth() const { return sliderGutterWidth; }
+        int getSliderHandleRadius() const { return sliderHandleRadius; }
+        int getKnobRingStrokeWidth(int forWidth) const
+        {
+            return forWidth < knobRingStrokeThreshold ? knobRingStrokeNarrow
+                                                      : knobRingStrokeWide;
+        }
+
+      private:
+        friend struct StyleSheet;
+        int32_t slotFor(const Class &c, const Property &p) const;
+
+        uint64_t generation{0}, inheritanceEpoch{0};
+        size_t rows{0}, stride{0};
+        // A property is either a colour or a font, so one grid indexes both value vectors
+        std::vector<int32_t> slots;
+        std::vector<juce::Colour> colours;
+        std::vector<FontHandle::ptr_t> fonts;
+
+        int sliderGutterWidth{0}, sliderHandleRadius{0};
+        int knobRingStrokeWide{0}, knobRingStrokeNarrow{0}, knobRingStrokeThreshold{0};
+    };
+
+    Snapshot::ptr_t snapshot();
 
     virtual int getSliderGutterWidth() const { return sliderGutterWidth; }
     virtual int getSliderHandleRadius() const { return sliderHandleRadius; }
@@ -174,23 +350,122 @@ struct StyleSheet
         return forWidth < knobRingStrokeThreshold ? knobRingStrokeNarrow : knobRingStrokeWide;
     }
 
-    virtual void setSliderGutterWidth(int w) { sliderGutterWidth = w; }
-    virtual void setSliderHandleRadius(int r) { sliderHandleRadius = r; }
+    virtual void setSliderGutterWidth(int w)
+    {
+        sliderGutterWidth = w;
+        noteEverythingChanged();
+    }
+    virtual void setSliderHandleRadius(int r)
+    {
+        sliderHandleRadius = r;
+        noteEverythingChanged();
+    }
     // wide stroke at/above threshold, narrow below it
     virtual void setKnobRingStrokeWidth(int wide, int narrow, int threshold)
     {
         knobRingStrokeWide = wide;
         knobRingStrokeNarrow = narrow;
         knobRingStrokeThreshold = threshold;
+        noteEverythingChanged();
     }
 
+    /*
+     * The generation increases monotonically on every mutation of this sheet. Consumers
+     * which cache resolved values compare it (and the global inheritanceEpoch) to know
+     * their cache is still good. Generations are drawn from a process wide counter so
+     * two sheets never share one. The public setters bump it (through noteChanged or
+     * noteEverythingChanged) once the doSet implementations below have made the change.
+     */
+    uint64_t getGeneration() const { return generation; }
+
+    /*
+     * Consumers which adopt this sheet attach themselves, bucketed by style class, so
+     * that a mutation only notifies and repaints the consumers whose class (or one of
+     * its base classes) had the changed property set. Whole tree propagation through
+     * StyleConsumer::setStyle and notifyOnStyleChanged is still available.
+     */
+    size_t getAttachedConsumerCount() const { return attachedConsumerCount; }
+
+    /*
+     * Mutations between beginBatch and commitBatch are collected and dispatched to the
+     * affected consumers in a single notify and repaint pass at the outermost commit, so
+     * live theme editing costs one refresh per edit rather than one per property. Batches
+     * nest. Prefer the RAII Batch guard.
+     */
+    void beginBatch() { batchDepth++; }
+    void commitBatch();
+    bool isInBatch() const { return batchDepth > 0; }
+
+    struct Batch
+    {
+        explicit Batch(StyleSheet &s) : sheet(s) { sheet.beginBatch(); }
+        ~Batch() { sheet.commitBatch(); }
+
+        Batch(const Batch &) = delete;
+        Batch &operator=(const Batch &) = delete;
+
+      private:
+        StyleSheet &sheet;
+    };
+
   protected:
+    void bumpGeneration() { generation = ++lastGeneration; }
+    uint64_t generation{++lastGeneration};
+    static uint64_t lastGeneration;
+
+    // Implementations call this from getColour/getFont when nothing resolves
+    static void noteMissing(const Class &c, const Property &p);
+
+    void noteChanged(const Class &c, const Property &p);
+    void noteEverythingChanged();
+    void dispatchPendingChanges();
+
+    // What the setters change; they notify afterwards, so implementations only store
+    virtual void doSetColour(const Class &c, const Property &p, const juce::Colour &) = 0;
+    virtual void doSetFont(const Class &c, const Property &p, const juce::Font &) = 0;
+    virtual void doReplaceFontsWithTypeface(const juce::Typeface::Ptr &p) = 0;
+    virtual void doReplaceFontsWithFamily(const juce::String &familyName) = 0;
+    virtual void doSetFontHeightDelta(float delta) = 0;
+    virtual void doSetFontExtraKerningFactor(float fac) = 0;
+
+    /*
+     * Does this sheet hold a value for the pair directly (without inheritance)? Targeted
+     * notification uses it to skip derived classes which shadow a changed property; the
+     * conservative default treats nothing as shadowed.
+     */
+    virtual bool definesById(int classId, int propertyId, Property::Type type) const
+    {
+        return false;
+    }
+
+    /*
+     * A font as the sheet holds it: the height setFontHeightDelta works from, and whether
+     * replaceFontsWithTypeface put it there (so its typeface has no name to load it by)
+     */
+    struct DirectFont
+    {
+        const juce::Font *font;
+        float baselineHeight;
+        bool replacedTypeface;
+    };
+
+    // Visits each directly defined value; exactly one of colour and font is non null
+    virtual void forEachDirectDefinition(
+        const std::function<void(int classId, int propertyId, const juce::Colour *colour,
+                                 const DirectFont *font)> &f) const
+    {
+    }
+
     int sliderGutterWidth{8};
     int sliderHandleRadius{7};
     int knobRingStrokeWide{5};
     int knobRingStrokeNarrow{3};
     int knobRingStrokeThreshold{21}; // width < 21 (i.e. <= 20) uses the narrow stroke
 
+    // The last setFontHeightDelta and setFontExtraKerningFactor, kept for themes
+    float fontHeightDelta{0.f};
+    float fontExtraKerningFactor{0.f};
+
   public:
     typedef std::shared_ptr<StyleSheet> ptr_t;
 
@@ -202,14 +477,96 @@ struct StyleSheet
     };
     static ptr_t getBuiltInStyleSheet(const BuiltInTypes &t);
 
+    /*
+     * Themes hold the colours and fonts a sheet defines directly, plus the slider and
+     * knob geometry; inherited values come from the inheritance map of the loading
+     * process. The binary form is for shipping and fast theme switching, the JSON form
+     * for authoring, and the two round trip losslessly.
+     *
+     * Class, property and typeface names are stored once in a string table which the
+     * fixed size entries index, so a theme survives builds whose registry ids differ.
+     * Loading maps each name to its id once and then writes entries straight into the
+     * flat tables of a new sheet, with no parsing or per-entry allocation for colours.
+     * The loaders return nullptr for malformed input. Only the built in sheet types
+     * (including EMPTY) enumerate their definitions; other subclasses write an empty
+     * theme unless they override forEachDirectDefinition.
+     *
+     * Fonts keep the baseline setFontHeightDelta works from, so a loaded sheet applies a
+     * later delta just as the original would. Fonts set by replaceFontsWithTypeface are
+     * marked as such, since an embedded typeface can't be found again by name. Pass that
+     * typeface to the loader to put it back; without it such a theme loads as nullptr
+     * rather than quietly falling back to the default typeface.
+     */
+    std::vector<uint8_t> toBinaryTheme() const;
+    std::string toJsonTheme() const;
+    static ptr_t fromBinaryTheme(const void *data, size_t size,
+                                 const juce::Typeface::Ptr &replacedTypeface = nullptr);
+    static ptr_t fromJsonTheme(const std::string &json,
+                               const juce::Typeface::Ptr &replacedTypeface = nullptr);
+
     friend struct StyleConsumer;
     friend struct Declaration;
 
-    std::ostream &dumpStyleSheetTo(std::ostream &os);
+    /*
+     * With withLookupProfile the dump ends with the lookup profile: for every (class,
+     * property) the sheets were asked for, the number of lookups, the time spent, and a
+     * histogram of how many base classes up the value resolved. The profile is process
+     * wide, counts lookups which reach a sheet (consumer cache hits don't), and is only
+     * collected when built with SST_JUCEGUI_STYLE_PROFILING.
+     */
+    std::ostream &dumpStyleSheetTo(std::ostream &os, bool withLookupProfile = false);
+    static void resetLookupProfile();
+
+    /*
+     * Lookups which find no value (and so paint red or a large italic font) are recorded
+     * here, once per (class, property) with a count of how often they were asked for,
+     * rather than logged on every paint. The first miss of each pair is still written to
+     * stdout as a single line. The registry is process wide and thread safe.
+     */
+    struct MissingStyle
+    {
+        std::string className, propertyName;
+        Property::Type type;
+        uint64_t hits;
+    };
+    static std::vector<MissingStyle> getMissingStyles();
+    static void clearMissingStyles();
+    static std::ostream &dumpMissingStylesTo(std::ostream &os);
 
   private:
     static void extendInheritanceMap(const StyleSheet::Class &from, const StyleSheet::Class &to);
-    static std::set<std::pair<std::string, std::string>> validPairs;
+    static std::set<std::pair<int, int>> validPairs;
+    static bool isValidPairById(int c, int p);
+    static std::unordered_map<uint64_t, int> classIdsByHash, propertyIdsByHash;
+    static int classIdForName(uint64_t hash, std::string_view name);
+    static int propertyIdForName(uint64_t hash, std::string_view name);
+
+    void attachConsumer(StyleConsumer *sc);
+    void detachConsumer(StyleConsumer *sc);
+    void markAffected(int classId, int propertyId, Property::Type type, bool isOrigin,
+                      std::vector<bool> &visited, std::vector<bool> &affected) const;
+
+    struct PendingChange
+    {
+        int classId;
+        int propertyId;
+        Property::Type type;
+    };
+    std::vector<PendingChange> pendingChanges;
+    bool pendingEverything{false};
+    int batchDepth{0};
+
+    std::vector<std::vector<StyleConsumer *>> consumersByClass;
+    size_t attachedConsumerCount{0};
+
+    /*
+     * The target lists of dispatches in progress (they nest if a handler edits the sheet).
+     * A consumer which detaches mid dispatch, because a handler destroyed or restyled it,
+     * is nulled out of these so the dispatch loop skips it.
+     */
+    std::vector<std::vector<StyleConsumer *> *> activeDispatches;
+
+    Snapshot::ptr_t latestSnapshot;
 
   public:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StyleSheet)
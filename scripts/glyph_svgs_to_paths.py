@@ -0,0 +1,545 @@
+#!/usr/bin/env python3
+#
+# Converts the glyph SVGs in res/glyphs into juce::Path data at build time, so
+# GlyphPainter can build its paths directly instead of parsing XML at runtime.
+#
+#   glyph_svgs_to_paths.py <output header> <svg> [<svg> ...]
+#
+# Each svg is named by the path it was given on the command line, which the
+# build passes relative to the source root to match the embedded resource names.
+#
+# Every drawn element becomes one layer: the element's outline in the stream
+# format read by juce::Path::loadPathFromData, whether it is filled, how it is
+# stroked and the outline of any clip-path applied to it. Only the subset of SVG
+# the glyphs actually use is understood, and anything else fails the build
+# rather than quietly drawing something different.
+
+import math
+import os
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+SVG_NS = "{http://www.w3.org/2000/svg}"
+
+# juce::PathStrokeType::JointStyle and EndCapStyle
+JOINS = {"miter": 0, "round": 1, "bevel": 2}
+CAPS = {"butt": 0, "square": 1, "round": 2}
+
+INHERITED = ["fill", "fill-rule", "stroke", "stroke-width", "stroke-linejoin", "stroke-linecap"]
+
+IGNORED_TAGS = {"title", "desc", "metadata"}
+
+
+def fail(msg):
+    sys.stderr.write("glyph_svgs_to_paths: " + msg + "\n")
+    sys.exit(1)
+
+
+def tag_of(el):
+    return el.tag[len(SVG_NS):] if el.tag.startswith(SVG_NS) else el.tag
+
+
+# Affine transforms as (a, b, c, d, e, f) mapping x, y to a*x + c*y + e, b*x + d*y + f
+IDENTITY = (1.0, 0.0, 0.0, 1.0, 0.0, 0.0)
+
+
+def multiply(m, n):
+    # apply n, then m
+    a, b, c, d, e, f = m
+    p, q, r, s, t, u = n
+    return (a * p + c * q, b * p + d * q, a * r + c * s, b * r + d * s, a * t + c * u + e,
+            b * t + d * u + f)
+
+
+def apply(m, x, y):
+    a, b, c, d, e, f = m
+    return (a * x + c * y + e, b * x + d * y + f)
+
+
+def parse_transform(s):
+    res = IDENTITY
+    for name, args in re.findall(r"([a-zA-Z]+)\s*\(([^)]*)\)", s or ""):
+        v = [float(x) for x in re.findall(r"[-+]?(?:\d*\.\d+|\d+\.?)(?:[eE][-+]?\d+)?", args)]
+        if name == "translate":
+            m = (1.0, 0.0, 0.0, 1.0, v[0], v[1] if len(v) > 1 else 0.0)
+        elif name == "scale":
+            m = (v[0], 0.0, 0.0, v[1] if len(v) > 1 else v[0], 0.0, 0.0)
+        elif name == "matrix":
+            m = tuple(v)
+        elif name == "rotate":
+            r = math.radians(v[0])
+            m = (math.cos(r), math.sin(r), -math.sin(r), math.cos(r), 0.0, 0.0)
+            if len(v) == 3:
+                m = multiply((1.0, 0.0, 0.0, 1.0, v[1], v[2]),
+                             multiply(m, (1.0, 0.0, 0.0, 1.0, -v[1], -v[2])))
+        else:
+            fail("unsupported transform " + name)
+        res = multiply(res, m)
+    return res
+
+
+class PathData:
+    """Builds the juce::Path stream: 'm' 'l' 'q' 'b' 'c' ops of little endian floats."""
+
+    def __init__(self, transform):
+        self.transform = transform
+        self.ops = bytearray()
+
+    def _op(self, code, *pts):
+        self.ops += code.encode()
+        for x, y in pts:
+            tx, ty = apply(self.transform, x, y)
+            self.ops += struct.pack("<ff", tx, ty)
+
+    def move(self, p):
+        self._op("m", p)
+
+    def line(self, p):
+        self._op("l", p)
+
+    def quad(self, c, p):
+        self._op("q", c, p)
+
+    def cubic(self, c1, c2, p):
+        self._op("b", c1, c2, p)
+
+    def close(self):
+        self.ops += b"c"
+
+    def extend(self, other):
+        self.ops += other.ops
+
+    def stream(self, non_zero=True):
+        return (b"n" if non_zero else b"z") + bytes(self.ops) + b"e"
+
+
+def arc_to_cubics(p0, rx, ry, phi_deg, large, sweep, p1):
+    """Endpoint arc parameters to cubic beziers, per the SVG implementation notes."""
+    if p0 == p1:
+        return []
+    rx, ry = abs(rx), abs(ry)
+    if rx == 0 or ry == 0:
+        return [(p0, p1, p1)]
+
+    phi = math.radians(phi_deg)
+    cp, sp = math.cos(phi), math.sin(phi)
+    dx, dy = (p0[0] - p1[0]) / 2, (p0[1] - p1[1]) / 2
+    x1p, y1p = cp * dx + sp * dy, -sp * dx + cp * dy
+
+    lam = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry)
+    if lam > 1:
+        rx, ry = rx * math.sqrt(lam), ry * math.sqrt(lam)
+
+    num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p
+    den = rx * rx * y1p * y1p + ry * ry * x1p * x1p
+    co = math.sqrt(max(0.0, num / den)) if den != 0 else 0.0
+    if large == sweep:
+        co = -co
+    cxp, cyp = co * rx * y1p / ry, -co * ry * x1p / rx
+    cx = cp * cxp - sp * cyp + (p0[0] + p1[0]) / 2
+    cy = sp * cxp + cp * cyp + (p0[1] + p1[1]) / 2
+
+    def angle(ux, uy, vx, vy):
+        return math.atan2(ux * vy - uy * vx, ux * vx + uy * vy)
+
+    t1 = angle(1, 0, (x1p - cxp) / rx, (y1p - cyp) / ry)
+    dt = angle((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry)
+    if not sweep and dt > 0:
+        dt -= 2 * math.pi
+    elif sweep and dt < 0:
+        dt += 2 * math.pi
+
+    def point(t):
+        x, y = rx * math.cos(t), ry * math.sin(t)
+        return (cp * x - sp * y + cx, sp * x + cp * y + cy)
+
+    def deriv(t):
+        x, y = -rx * math.sin(t), ry * math.cos(t)
+        return (cp * x - sp * y, sp * x + cp * y)
+
+    segs = max(1, int(math.ceil(abs(dt) / (math.pi / 2) - 1e-9)))
+    step = dt / segs
+    k = 4.0 / 3.0 * math.tan(step / 4)
+    res = []
+    for i in range(segs):
+        a, b = t1 + i * step, t1 + (i + 1) * step
+        pa, pb = point(a), point(b)
+        da, db = deriv(a), deriv(b)
+        res.append(((pa[0] + k * da[0], pa[1] + k * da[1]), (pb[0] - k * db[0], pb[1] - k * db[1]),
+                    p1 if i == segs - 1 else pb))
+    return res
+
+
+NUMBER = re.compile(r"[-+]?(?:\d*\.\d+|\d+\.?)(?:[eE][-+]?\d+)?")
+
+
+def tokenize_path(d):
+    i, n = 0, len(d)
+    while i < n:
+        ch = d[i]
+        if ch in " \t\r\n,":
+            i += 1
+        elif ch.isalpha():
+            yield ch
+            i += 1
+        else:
+            m = NUMBER.match(d, i)
+            if not m:
+                fail("bad path data near '" + d[i:i + 10] + "'")
+            yield m.group(0)
+            i = m.end()
+
+
+def parse_path(d, out):
+    tokens = list(tokenize_path(d))
+    pos = 0
+
+    def number():
+        nonlocal pos
+        tok = tokens[pos]
+        pos += 1
+        return float(tok)
+
+    def flag():
+        # flags may be packed against what follows, as in "a1 1 0 011 1"
+        nonlocal pos
+        tok = tokens[pos]
+        if tok[0] not in "01":
+            fail("bad arc flag " + tok)
+        if len(tok) > 1:
+            tokens[pos] = tok[1:]
+        else:
+            pos += 1
+        return tok[0] == "1"
+
+    def has_number():
+        return pos < len(tokens) and not tokens[pos].isalpha()
+
+    cur = (0.0, 0.0)
+    start = (0.0, 0.0)
+    last_ctrl = None
+    last_cmd = ""
+    closed = False
+    cmd = None
+
+    while pos < len(tokens):
+        if tokens[pos].isalpha():
+            cmd = tokens[pos]
+            pos += 1
+        elif cmd is None:
+            fail("path data must start with a command")
+
+        rel = cmd.islower()
+        c = cmd.upper()
+
+        def pt():
+            x, y = number(), number()
+            return (cur[0] + x, cur[1] + y) if rel else (x, y)
+
+        if closed and c != "M":
+            # drawing on after a close starts a fresh subpath from the close point
+            out.move(cur)
+        closed = False
+
+        if c == "Z":
+            out.close()
+            cur = start
+            closed = True
+            last_cmd = c
+            continue
+
+        if c == "M":
+            cur = pt()
+            start = cur
+            out.move(cur)
+            last_cmd = c
+            # further pairs are implicit linetos
+            cmd = "l" if rel else "L"
+            if not has_number():
+                continue
+            rel = cmd.islower()
+            c = "L"
+
+        while True:
+            if c == "L":
+                cur = pt()
+                out.line(cur)
+            elif c == "H":
+                x = number()
+                cur = (cur[0] + x if rel else x, cur[1])
+                out.line(cur)
+            elif c == "V":
+                y = number()
+                cur = (cur[0], cur[1] + y if rel else y)
+                out.line(cur)
+            elif c == "C":
+                c1, c2, p = pt(), pt(), pt()
+                out.cubic(c1, c2, p)
+                cur, last_ctrl = p, c2
+            elif c == "S":
+                c1 = cur
+                if last_cmd in "CS" and last_ctrl:
+                    c1 = (2 * cur[0] - last_ctrl[0], 2 * cur[1] - last_ctrl[1])
+                c2, p = pt(), pt()
+                out.cubic(c1, c2, p)
+                cur, last_ctrl = p, c2
+            elif c == "Q":
+                c1, p = pt(), pt()
+                out.quad(c1, p)
+                cur, last_ctrl = p, c1
+            elif c == "T":
+                c1 = cur
+                if last_cmd in "QT" and last_ctrl:
+                    c1 = (2 * cur[0] - last_ctrl[0], 2 * cur[1] - last_ctrl[1])
+                p = pt()
+                out.quad(c1, p)
+                cur, last_ctrl = p, c1
+            elif c == "A":
+                rx, ry, rot = number(), number(), number()
+                large, sweep = flag(), flag()
+                p = pt()
+                for c1, c2, q in arc_to_cubics(cur, rx, ry, rot, large, sweep, p):
+                    out.cubic(c1, c2, q)
+                cur = p
+            else:
+                fail("unsupported path command " + cmd)
+            last_cmd = c
+            if not has_number():
+                break
+
+
+def rounded_rect(out, x, y, w, h, rx, ry):
+    k = 0.5522847498
+    rx, ry = min(rx, w / 2), min(ry, h / 2)
+    out.move((x + rx, y))
+    out.line((x + w - rx, y))
+    out.cubic((x + w - rx + k * rx, y), (x + w, y + ry - k * ry), (x + w, y + ry))
+    out.line((x + w, y + h - ry))
+    out.cubic((x + w, y + h - ry + k * ry), (x + w - rx + k * rx, y + h), (x + w - rx, y + h))
+    out.line((x + rx, y + h))
+    out.cubic((x + rx - k * rx, y + h), (x, y + h - ry + k * ry), (x, y + h - ry))
+    out.line((x, y + ry))
+    out.cubic((x, y + ry - k * ry), (x + rx - k * rx, y), (x + rx, y))
+    out.close()
+
+
+def shape_outline(el, transform):
+    """The element's outline in viewbox coordinates, or None if it isn't a shape."""
+    tag = tag_of(el)
+    out = PathData(transform)
+    f = lambda k, d=0.0: float(el.get(k, d))
+    if tag == "path":
+        parse_path(el.get("d", ""), out)
+    elif tag == "rect":
+        x, y, w, h = f("x"), f("y"), f("width"), f("height")
+        rx, ry = el.get("rx"), el.get("ry")
+        if rx is None and ry is None:
+            out.move((x, y))
+            out.line((x + w, y))
+            out.line((x + w, y + h))
+            out.line((x, y + h))
+            out.close()
+        else:
+            rx = float(rx if rx is not None else ry)
+            ry = float(ry if ry is not None else rx)
+            rounded_rect(out, x, y, w, h, rx, ry)
+    elif tag in ("circle", "ellipse"):
+        cx, cy = f("cx"), f("cy")
+        rx = f("r") if tag == "circle" else f("rx")
+        ry = f("r") if tag == "circle" else f("ry")
+        rounded_rect(out, cx - rx, cy - ry, 2 * rx, 2 * ry, rx, ry)
+    elif tag in ("polygon", "polyline", "line"):
+        if tag == "line":
+            pts = [f("x1"), f("y1"), f("x2"), f("y2")]
+        else:
+            pts = [float(v) for v in NUMBER.findall(el.get("points", ""))]
+        out.move((pts[0], pts[1]))
+        for i in range(2, len(pts) - 1, 2):
+            out.line((pts[i], pts[i + 1]))
+        if tag == "polygon":
+            out.close()
+    else:
+        return None
+    return out
+
+
+def convert(filename):
+    root = ET.parse(filename).getroot()
+    if tag_of(root) != "svg":
+        fail(filename + " is not an svg")
+
+    clips = {}
+    for cp in root.iter(SVG_NS + "clipPath"):
+        data = PathData(IDENTITY)
+        for child in cp:
+            o = shape_outline(child, parse_transform(child.get("transform")))
+            if o is None:
+                fail(filename + ": unsupported clip element " + tag_of(child))
+            data.extend(o)
+        clips[cp.get("id")] = data
+
+    transform = IDENTITY
+    vb = root.get("viewBox")
+    if vb:
+        vx, vy, vw, vh = [float(v) for v in NUMBER.findall(vb)]
+        w = float(re.sub("px$", "", root.get("width", str(vw))))
+        h = float(re.sub("px$", "", root.get("height", str(vh))))
+        transform = multiply((w / vw, 0.0, 0.0, h / vh, 0.0, 0.0),
+                             (1.0, 0.0, 0.0, 1.0, -vx, -vy))
+
+    layers = []
+
+    def clip_ref(el):
+        ref = el.get("clip-path")
+        if not ref:
+            return None
+        m = re.match(r"url\(#([^)]+)\)", ref)
+        if not m or m.group(1) not in clips:
+            fail(filename + ": unknown clip-path " + ref)
+        return clips[m.group(1)]
+
+    def walk(el, transform, style, clip):
+        tag = tag_of(el)
+        if tag in ("defs", "clipPath") or tag in IGNORED_TAGS:
+            return
+
+        style = dict(style)
+        for k in INHERITED:
+            if el.get(k) is not None:
+                style[k] = el.get(k)
+        transform = multiply(transform, parse_transform(el.get("transform")))
+        own_clip = clip_ref(el)
+        if own_clip is not None:
+            if clip is not None:
+                fail(filename + ": nested clip paths are not supported")
+            # the clip lives in the user space of the element referencing it
+            clip = PathData(transform)
+            replay(own_clip, clip)
+
+        if tag in ("svg", "g"):
+            for child in el:
+                walk(child, transform, style, clip)
+            return
+
+        outline = shape_outline(el, transform)
+        if outline is None:
+            fail(filename + ": unsupported element " + tag)
+
+        fill = style.get("fill", "black") != "none"
+        stroke = style.get("stroke", "none") != "none"
+        if not fill and not stroke:
+            return
+
+        a, b, c, d = transform[:4]
+        width = float(style.get("stroke-width", "1")) * math.sqrt(abs(a * d - b * c))
+        join = style.get("stroke-linejoin", "miter")
+        cap = style.get("stroke-linecap", "butt")
+        if join not in JOINS or cap not in CAPS:
+            fail(filename + ": unsupported stroke style " + join + " " + cap)
+
+        layers.append({
+            "path": outline.stream(style.get("fill-rule", "nonzero") != "evenodd"),
+            "fill": fill,
+            "strokeWidth": width if stroke else 0.0,
+            "join": JOINS[join],
+            "cap": CAPS[cap],
+            "clip": clip.stream() if clip is not None else None,
+        })
+
+    walk(root, transform, {}, None)
+    if not layers:
+        fail(filename + " draws nothing")
+    return layers
+
+
+def replay(src, dst):
+    """Replays an untransformed PathData into one carrying a transform."""
+    ops, i = src.ops, 0
+    counts = {"m": 1, "l": 1, "q": 2, "b": 3, "c": 0}
+    while i < len(ops):
+        code = chr(ops[i])
+        i += 1
+        pts = []
+        for _ in range(counts[code]):
+            pts.append(struct.unpack_from("<ff", ops, i))
+            i += 8
+        if code == "c":
+            dst.close()
+        else:
+            dst._op(code, *pts)
+
+
+def c_bytes(data):
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(rows)
+
+
+def identifier(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name)
+
+
+def main():
+    if len(sys.argv) < 3:
+        fail("usage: glyph_svgs_to_paths.py <output header> <svg>...")
+
+    out = [
+        "// Generated from the glyph SVGs by scripts/glyph_svgs_to_paths.py. Do not edit.",
+        "",
+        "#include <cstddef>",
+        "#include <cstdint>",
+        "",
+        "namespace sst::jucegui::components::glyph_paths",
+        "{",
+        "struct Layer",
+        "{",
+        "    const uint8_t *path; // juce::Path::loadPathFromData format",
+        "    size_t pathSize;",
+        "    bool fill;",
+        "    float strokeWidth; // zero for no stroke",
+        "    int strokeJoin;    // juce::PathStrokeType::JointStyle",
+        "    int strokeCap;     // juce::PathStrokeType::EndCapStyle",
+        "    const uint8_t *clip; // nullptr for no clip",
+        "    size_t clipSize;",
+        "};",
+        "",
+        "struct Glyph",
+        "{",
+        "    const char *resource;",
+        "    const Layer *layers;",
+        "    size_t numLayers;",
+        "};",
+        "",
+    ]
+
+    glyphs = []
+    for filename in sys.argv[2:]:
+        base = identifier(filename)
+        layer_lines = []
+        for i, l in enumerate(convert(filename)):
+            pn = "%s_%d_path" % (base, i)
+            out += ["static const uint8_t %s[] = {" % pn, c_bytes(l["path"]), "};"]
+            clip = "nullptr, 0"
+            if l["clip"] is not None:
+                cn = "%s_%d_clip" % (base, i)
+                out += ["static const uint8_t %s[] = {" % cn, c_bytes(l["clip"]), "};"]
+                clip = "%s, sizeof(%s)" % (cn, cn)
+            layer_lines.append("    {%s, sizeof(%s), %s, %ff, %d, %d, %s}," %
+                               (pn, pn, "true" if l["fill"] else "false", l["strokeWidth"],
+                                l["join"], l["cap"], clip))
+        out += ["static const Layer %s_layers[] = {" % base] + layer_lines + ["};", ""]
+        glyphs.append('    {"%s", %s_layers, %d},' % (filename, base, len(layer_lines)))
+
+    out += ["static const Glyph glyphs[] = {"] + glyphs + ["};", "",
+            "} // namespace sst::jucegui::components::glyph_paths", ""]
+
+    os.makedirs(os.path.dirname(os.path.abspath(sys.argv[1])), exist_ok=True)
+    with open(sys.argv[1], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,144 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#ifndef INCLUDE_SST_JUCEGUI_COMPONENTS_CONTINUOUSEDITS_HXX
+#define INCLUDE_SST_JUCEGUI_COMPONENTS_CONTINUOUSEDITS_HXX
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/data/Continuous.h>
+
+namespace sst::jucegui::components
+{
+/*
+ * The value maths of mouse and keyboard edits, shared by ContinuousParamEditor and the
+ * cells of a ParameterBank. Each takes the data being edited and mod, which is non null
+ * when the edit is of the modulation depth rather than the value.
+ */
+
+// What an edit clamps to; modulation depths run over -1 to 1
+inline std::pair<float, float> continuousEditRange(data::Continuous *c,
+                                                   data::ContinuousModulatable *mod)
+{
+    if (mod)
+        return {-1.f, 1.f};
+    return {c->getMin(), c->getMax()};
+}
+
+/*
+ * The change a drag of dx, dy pixels makes. Vertical editors cross their range in 150
+ * pixels and horizontal ones in their width, with movement across the editor counting
+ * for a tenth.
+ */
+inline float continuousDragDelta(data::Continuous *c, data::ContinuousModulatable *mod,
+                                 bool vertical, float width, float dx, float dy,
+                                 float sensitivity, const juce::ModifierKeys &mods)
+{
+    float minForScaling = c->getMin();
+    float maxForScaling = c->getMax();
+    if (mod)
+    {
+        if (mod->isModulationBipolar())
+            minForScaling = -1.0f;
+        else
+            minForScaling = 0.0f;
+        maxForScaling = 1.0f;
+    }
+
+    float d = 0;
+    if (vertical)
+    {
+        d = (dx * 0.1 + dy) / 150.0 * (maxForScaling - minForScaling);
+    }
+    else
+    {
+        // the width probably isn't exactly right here, but better than the constant
+        d = (dx + 0.1 * dy) / width * (maxForScaling - minForScaling);
+    }
+    d *= sensitivity;
+    if (mods.isShiftDown())
+        d = d * 0.1;
+    if (mod && mod->isModulationBipolar())
+        d = d * 0.5;
+    return d;
+}
+
+// The signed wheel movement of an event, or zero if there is too little to act on
+inline float continuousWheelMovement(const juce::MouseEvent &e,
+                                     const juce::MouseWheelDetails &wheel)
+{
+    auto dy = wheel.deltaY;
+#if JUCEGUI_MAC
+    // On a mac with a traditional mouse with a unidirectional wheel, shift will swap deltax and
+    // deltay making deltaY exactly zero
+    if (e.mods.isShiftDown() && wheel.deltaY == 0.0)
+    {
+        dy = wheel.deltaX;
+    }
+#endif
+
+    if (std::fabs(dy) < 0.0001)
+        return 0;
+    return (wheel.isReversed ? -1 : 1) * dy;
+}
+
+// The change a wheel movement makes
+inline float continuousWheelDelta(data::Continuous *c, data::ContinuousModulatable *mod,
+                                  float movement, float scaling, bool quantized,
+                                  const juce::ModifierKeys &mods)
+{
+    // fixme - callibration
+    auto d = movement * (mod ? 2.f : c->getMax() - c->getMin());
+    // Probably need a speedup if quantized but again this all needs callibrating.
+    if (!mod && quantized)
+    {
+        d *= 5;
+    }
+#if JUCEGUI_WIN || JUCEGUI_LIN
+    d *= 0.025;
+#endif
+    d *= scaling;
+
+    if (mods.isShiftDown())
+        d = d * 0.1;
+    return d;
+}
+
+/*
+ * Where a keyboard step from v lands: 2.5% of the range, a tenth of that when fine, or
+ * one quantized step when quantized.
+ */
+inline float continuousKeyStep(data::Continuous *c, float v, bool increase, bool fine,
+                               bool quantized)
+{
+    auto sgn = increase ? 1.f : -1.f;
+    if (quantized)
+        return c->quantizeValue(
+            std::clamp(v + c->getQuantizedStepSize() * sgn, c->getMin(), c->getMax()));
+
+    auto delt = sgn * (c->getMax() - c->getMin()) * 0.025f;
+    if (fine)
+        delt *= 0.1;
+    return std::clamp(v + delt, c->getMin(), c->getMax());
+}
+} // namespace sst::jucegui::components
+
+#endif // INCLUDE_SST_JUCEGUI_COMPONENTS_CONTINUOUSEDITS_HXX
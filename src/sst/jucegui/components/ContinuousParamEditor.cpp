@@ -18,6 +18,7 @@
 #include <sst/jucegui/components/ContinuousParamEditor.h>
 #include <sst/jucegui/components/NamedPanel.h>
 #include <sst/jucegui/components/TypeInOverlay.h>
+#include "ContinuousEdits.hxx"
 #include <algorithm>
 
 namespace sst::jucegui::components
@@ -28,7 +29,13 @@ ContinuousParamEditor::ContinuousParamEditor(Direction dir) : direction(dir)
     setWantsKeyboardFocus(true);
     setTitle("UnNamed Continuous");
 }
-ContinuousParamEditor::~ContinuousParamEditor() = default;
+ContinuousParamEditor::~ContinuousParamEditor()
+{
+    // Normally a wheel edit has ended as the editor stopped showing. If not, a held write only
+    // points at the data so can still go out, but onEndEdit can't; see setValueEmissionRateHz
+    flushValueWrite();
+    wheelEditOpen = false;
+}
 
 void ContinuousParamEditor::mouseDown(const juce::MouseEvent &e)
 {
@@ -46,11 +53,8 @@ void ContinuousParamEditor::mouseDown(const juce::MouseEvent &e)
     }
 
     mouseMode = DRAG;
-    onBeginEdit();
-    if (isEditingMod && continuousModulatable())
-        mouseDownV0 = continuousModulatable()->getModulationValuePM1();
-    else
-        mouseDownV0 = continuous()->getValue();
+    beginEdit();
+    mouseDownV0 = getEditedValue();
     mouseDownY0 = e.position.y;
     mouseDownX0 = e.position.x;
 }
@@ -60,7 +64,7 @@ void ContinuousParamEditor::mouseUp(const juce::MouseEvent &e)
         return;
 
     if (mouseMode == DRAG)
-        onEndEdit();
+        endEdit();
     mouseMode = NONE;
 }
 
@@ -69,12 +73,12 @@ void ContinuousParamEditor::mouseDoubleClick(const juce::MouseEvent &e)
     if (!processMouseActions())
         return;
 
-    onBeginEdit();
-    continuous()->setValueFromGUI(continuous()->getDefaultValue());
+    beginEdit();
+    writeOwnValue([&]() { continuous()->setValueFromGUI(continuous()->getDefaultValue()); });
     notifyAccessibleChange();
-    onEndEdit();
+    endEdit();
 
-    repaint();
+    repaintValue();
 }
 
 void ContinuousParamEditor::mouseDrag(const juce::MouseEvent &e)
@@ -85,56 +89,20 @@ void ContinuousParamEditor::mouseDrag(const juce::MouseEvent &e)
     if (mouseMode != DRAG)
         return;
 
-    float dy = -(e.position.y - mouseDownY0);
-    float dx = (e.position.x - mouseDownX0);
-    float d = 0;
-    float minForScaling = continuous()->getMin();
-    float maxForScaling = continuous()->getMax();
-    if (isEditingMod && continuousModulatable())
-    {
-        if (continuousModulatable()->isModulationBipolar())
-            minForScaling = -1.0f;
-        else
-            minForScaling = 0.0f;
-        maxForScaling = 1.0f;
-    }
-    if (direction == VERTICAL)
-    {
-        d = (dx * 0.1 + dy) / 150.0 * (maxForScaling - minForScaling);
-    }
-    else
-    {
-        // getWidth probably isn't exactly right here, but better than the constant
-        d = (dx + 0.1 * dy) / (float)getWidth() * (maxForScaling - minForScaling);
-    }
-    if (e.mods.isShiftDown())
-        d = d * 0.1;
-    if (isEditingMod && continuousModulatable())
-    {
-        if (continuousModulatable()->isModulationBipolar())
-            d = d * 0.5;
-        auto vn = std::clamp(mouseDownV0 + d, -1.f, 1.f);
-        continuousModulatable()->setModulationValuePM1(vn);
-        mouseDownV0 = vn;
-    }
-    else
-    {
-        auto vn = std::clamp(mouseDownV0 + d, continuous()->getMin(), continuous()->getMax());
-        if (e.mods.isCommandDown() || alwaysQuantize)
-        {
-            continuous()->setValueFromGUIQuantized(vn);
-        }
-        else
-        {
-            continuous()->setValueFromGUI(vn);
-        }
+    auto *mod = isEditingMod ? continuousModulatable() : nullptr;
+    auto d = continuousDragDelta(continuous(), mod, direction == VERTICAL, (float)getWidth(),
+                                 e.position.x - mouseDownX0, -(e.position.y - mouseDownY0),
+                                 getSetting(style::Settings::dragSensitivity), e.mods);
+    auto [lo, hi] = continuousEditRange(continuous(), mod);
+    auto vn = std::clamp(mouseDownV0 + d, lo, hi);
+    emitEditedValue(vn, !mod && (e.mods.isCommandDown() || alwaysQuantize));
+    if (!mod)
         notifyAccessibleChange();
-        mouseDownV0 = vn;
-    }
+    mouseDownV0 = vn;
     mouseDownX0 = e.position.x;
     mouseDownY0 = e.position.y;
 
-    repaint();
+    repaintValue();
 }
 void ContinuousParamEditor::mouseWheelMove(const juce::MouseEvent &e,
                                            const juce::MouseWheelDetails &wheel)
@@ -142,69 +110,27 @@ void ContinuousParamEditor::mouseWheelMove(const juce::MouseEvent &e,
     if (!processMouseActions())
         return;
 
-    auto dy = wheel.deltaY;
-#if JUCEGUI_MAC
-    // On a mac with a traditional mouse with a unidirectional wheel, shift will swap deltax and
-    // deltay making deltaY exactly zero
-    if (e.mods.isShiftDown() && wheel.deltaY == 0.0)
-    {
-        dy = wheel.deltaX;
-    }
-#endif
-
-    if (fabs(dy) < 0.0001)
+    auto movement = continuousWheelMovement(e, wheel);
+    if (movement == 0)
         return;
-    onBeginEdit();
-
-    if (isEditingMod && continuousModulatable())
-    {
-        // fixme - callibration and sharing
-        auto d = (wheel.isReversed ? -1 : 1) * dy * (2);
-#if JUCEGUI_WIN || JUCEGUI_LIN
-        d *= 0.025;
-#endif
-
-        if (e.mods.isShiftDown())
-            d = d * 0.1;
-
-        auto vn = std::clamp(continuousModulatable()->getModulationValuePM1() + d, -1.f, 1.f);
-        continuousModulatable()->setModulationValuePM1(vn);
-    }
-    else
-    {
-        // fixme - callibration and sharing
-        auto d =
-            (wheel.isReversed ? -1 : 1) * dy * (continuous()->getMax() - continuous()->getMin());
-        // Probably need a speedup if quantized but again this all needs callibrating.
-        if (e.mods.isCommandDown() || alwaysQuantize)
-        {
-            d *= 5;
-        }
-#if JUCEGUI_WIN || JUCEGUI_LIN
-        d *= 0.025;
-#endif
-
-        if (e.mods.isShiftDown())
-            d = d * 0.1;
-
-        auto vn = std::clamp(continuous()->getValue() + d, continuous()->getMin(),
-                             continuous()->getMax());
-        if (e.mods.isCommandDown() || alwaysQuantize)
-        {
-            continuous()->setValueFromGUIQuantized(vn);
-        }
-        else
-        {
-            continuous()->setValueFromGUI(vn);
-        }
+    beginWheelEdit();
+    if (wheelEditOpen && !wheelEditVisibilityWatcher)
+        wheelEditVisibilityWatcher = std::make_unique<util::VisibilityParentWatcher>(this);
+
+    auto *mod = isEditingMod ? continuousModulatable() : nullptr;
+    auto quantized = !mod && (e.mods.isCommandDown() || alwaysQuantize);
+    auto d = continuousWheelDelta(continuous(), mod, movement,
+                                  getSetting(style::Settings::wheelScaling), quantized, e.mods);
+    auto [lo, hi] = continuousEditRange(continuous(), mod);
+    emitEditedValue(std::clamp(getEditedValue() + d, lo, hi), quantized);
+    if (!mod)
         notifyAccessibleChange();
-    }
-    onEndEdit();
+    endWheelEdit();
 
     if (onWheelEditOccurred)
         onWheelEditOccurred();
 
-    repaint();
+    repaintValue();
 }
 
 bool ContinuousParamEditor::processMouseActions()
@@ -231,50 +157,41 @@ bool ContinuousParamEditor::keyPressed(const juce::KeyPress &k)
         switch (a.action)
         {
         case act::Action::ToMax:
-            onBeginEdit();
-            continuous()->setValueFromGUI(continuous()->getMax());
+            beginEdit();
+            writeOwnValue([&]() { continuous()->setValueFromGUI(continuous()->getMax()); });
             notifyAccessibleChange();
-            repaint();
-            onEndEdit();
+            repaintValue();
+            endEdit();
             return true;
         case act::Action::ToMin:
-            onBeginEdit();
-            continuous()->setValueFromGUI(continuous()->getMin());
+            beginEdit();
+            writeOwnValue([&]() { continuous()->setValueFromGUI(continuous()->getMin()); });
             notifyAccessibleChange();
-            repaint();
-            onEndEdit();
+            repaintValue();
+            endEdit();
             return true;
         case act::Action::ToDefault:
-            onBeginEdit();
-            continuous()->setValueFromGUI(continuous()->getDefaultValue());
+            beginEdit();
+            writeOwnValue(
+                [&]() { continuous()->setValueFromGUI(continuous()->getDefaultValue()); });
             notifyAccessibleChange();
-            repaint();
-            onEndEdit();
+            repaintValue();
+            endEdit();
             return true;
 
         case act::Action::Increase:
         case act::Action::Decrease:
         {
-            auto range = (continuous()->getMax() - continuous()->getMin());
-            auto sgn = a.action == act::Action::Increase ? 1.f : -1.f;
-            auto delt = sgn * range * 0.025f;
-            if (a.mod == act::Action::Fine)
-                delt *= 0.1;
-
-            auto vn = std::clamp(continuous()->getValue() + delt, continuous()->getMin(),
-                                 continuous()->getMax());
-            if (a.mod == act::Action::Quantized || alwaysQuantize)
-            {
-                vn = std::clamp(continuous()->getValue() +
-                                    continuous()->getQuantizedStepSize() * sgn,
-                                continuous()->getMin(), continuous()->getMax());
-                vn = continuous()->quantizeValue(vn);
-            }
-            onBeginEdit();
-            continuous()->setValueFromGUI(vn);
-            repaint();
+            // begin first, so a held wheel write lands before we step from the value
+            beginEdit();
+            auto vn = continuousKeyStep(continuous(), continuous()->getValue(),
+                                        a.action == act::Action::Increase,
+                                        a.mod == act::Action::Fine,
+                                        a.mod == act::Action::Quantized || alwaysQuantize);
+            writeOwnValue([&]() { continuous()->setValueFromGUI(vn); });
+            repaintValue();
             notifyAccessibleChange();
-            onEndEdit();
+            endEdit();
         }
         break;
         case act::Action::OpenEditor:
@@ -313,10 +230,10 @@ struct ContinuousParamEditorAH : public juce::AccessibilityHandler
             if (!slider->continuous())
                 return;
 
-            slider->onBeginEdit();
+            slider->beginEdit();
             slider->continuous()->setValueFromGUI(newValue);
             slider->notifyAccessibleChange();
-            slider->onEndEdit();
+            slider->endEdit();
         }
         juce::String getCurrentValueAsString() const override
         {
@@ -330,10 +247,10 @@ struct ContinuousParamEditorAH : public juce::AccessibilityHandler
             if (!slider->continuous())
                 return;
 
-            slider->onBeginEdit();
+            slider->beginEdit();
             slider->continuous()->setValueAsString(newValue.toStdString());
             slider->notifyAccessibleChange();
-            slider->onEndEdit();
+            slider->endEdit();
         }
         AccessibleValueRange getRange() const override
         {
@@ -384,6 +301,33 @@ void ContinuousParamEditor::notifyAccessibleChange()
     }
 }
 
+void ContinuousParamEditor::emitEditedValue(float v, bool quantized)
+{
+    heldValue = v;
+    if (isEditingMod && continuousModulatable())
+    {
+        emitValueWrite([m = continuousModulatable(), v]() { m->setModulationValuePM1(v); });
+    }
+    else
+    {
+        emitValueWrite([c = continuous(), v, quantized]() {
+            if (quantized)
+                c->setValueFromGUIQuantized(v);
+            else
+                c->setValueFromGUI(v);
+        });
+    }
+}
+
+float ContinuousParamEditor::getEditedValue()
+{
+    if (hasPendingValueWrite())
+        return heldValue;
+    if (isEditingMod && continuousModulatable())
+        return continuousModulatable()->getModulationValuePM1();
+    return continuous()->getValue();
+}
+
 void ContinuousParamEditor::initiateTypeIn()
 {
     auto *c = getParentComponent();
@@ -27,7 +27,11 @@ DraggableTextEditableValue::DraggableTextEditableValue()
     initTextEditor();
 }
 
-DraggableTextEditableValue::~DraggableTextEditableValue() = default;
+DraggableTextEditableValue::~DraggableTextEditableValue()
+{
+    // our held writes set the drag guard on us, so send them while we are still whole
+    flushValueWrite();
+}
 
 void DraggableTextEditableValue::paint(juce::Graphics &g) { paintFor(this, g); }
 
@@ -48,13 +52,13 @@ void DraggableTextEditableValue::mouseDrag(const juce::MouseEvent &e)
     auto fac = dragScale * (e.mods.isShiftDown() ? dragShiftRatio : 1.f);
     auto nv = valueOnMouseDown - fac * d * continuous()->getMinMaxRange() * 0.01f;
     nv = std::clamp(nv, continuous()->getMin(), continuous()->getMax());
-    {
+    emitValueWrite([this, c = continuous(), nv, quantized = e.mods.isCommandDown()]() {
         auto eidg = EditIsDragGuard(*this);
-        if (e.mods.isCommandDown())
-            continuous()->setValueFromGUIQuantized(nv);
+        if (quantized)
+            c->setValueFromGUIQuantized(nv);
         else
-            continuous()->setValueFromGUI(nv);
-    }
+            c->setValueFromGUI(nv);
+    });
     repaint();
 }
 
@@ -63,14 +63,14 @@ void GlyphButton::paint(juce::Graphics &g)
 
         auto b1 = getLocalBounds().withWidth(glyphZeroWidth);
         auto b2 = getLocalBounds().withTrimmedLeft(glyphZeroWidth);
-        GlyphPainter::paintGlyph(g, squareCenter(b1), glyph, col);
-        GlyphPainter::paintGlyph(g, squareCenter(b2), *secondGlyph, col);
+        GlyphPainter::paintGlyph(g, squareCenter(b1), glyph, col, this);
+        GlyphPainter::paintGlyph(g, squareCenter(b2), *secondGlyph, col, this);
     }
     else
     {
         auto b = squareCenter(getLocalBounds().reduced(glyphButtonPad));
 
-        GlyphPainter::paintGlyph(g, b, glyph, col);
+        GlyphPainter::paintGlyph(g, b, glyph, col, this);
     }
 }
 } // namespace sst::jucegui::components
\ No newline at end of file
@@ -17,8 +17,17 @@
 
 #include <sst/jucegui/components/GlyphPainter.h>
 
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 #include <cmrc/cmrc.hpp>
 
+#if SST_JUCEGUI_PRECOMPILED_GLYPHS
+#include "GlyphPathData.h"
+#endif
+
 CMRC_DECLARE(sst::jucegui::resources);
 
 namespace sst::jucegui::components
@@ -85,52 +94,149 @@ void paintMonoGlyph(juce::Graphics &g, const juce::Rectangle<int> &into)
     }
 }
 
-void paintFromSvg(juce::Graphics &g, const juce::Rectangle<int> &into, const std::string &path,
-                  int32_t baseColor, int overW, int overH, const juce::Colour &to)
+/*
+ * SVG glyphs, keyed by resource path, built once per process on first paint or in
+ * GlyphPainter::preloadAll. The glyphs in res/glyphs come from path data converted at
+ * build time by scripts/glyph_svgs_to_paths.py; any other resource is parsed as SVG.
+ * A missing or unparseable file is remembered too so it isn't retried on every paint.
+ * The cache is torn down with the rest of JUCE at shutdown.
+ */
+struct SvgGlyphCache : juce::DeletedAtShutdown
 {
-    std::unordered_map<std::string, std::unique_ptr<juce::Drawable>> dbls;
-    auto dbIt = dbls.find(path);
-    if (dbIt == dbls.end())
+    // One drawn SVG element, with any stroke already turned into an outline
+    struct PathLayer
+    {
+        juce::Path fill, stroke;
+        bool clipped{false};
+        juce::Path clip;
+    };
+    struct Entry
+    {
+        bool found{false};
+        std::vector<PathLayer> layers;
+        std::unique_ptr<juce::Drawable> drawable;
+
+        bool canDraw() const { return drawable || !layers.empty(); }
+    };
+    std::unordered_map<std::string, Entry> entries;
+
+    static SvgGlyphCache *instance;
+    static SvgGlyphCache &get()
+    {
+        if (!instance)
+            instance = new SvgGlyphCache();
+        return *instance;
+    }
+    ~SvgGlyphCache() { instance = nullptr; }
+
+    Entry &entryFor(const std::string &path)
     {
+        auto it = entries.find(path);
+        if (it != entries.end())
+            return it->second;
+
+        auto &res = entries[path];
+#if SST_JUCEGUI_PRECOMPILED_GLYPHS
+        if (loadPrecompiled(path, res))
+            return res;
+#endif
         auto fs = cmrc::sst::jucegui::resources::get_filesystem();
         try
         {
             auto stp = fs.open(path);
-            auto svg = std::string(stp.begin(), stp.end());
-            auto res = juce::Drawable::createFromImageData(svg.data(), svg.size());
-            dbls[path] = std::move(res);
+            res.found = true;
+            res.drawable = juce::Drawable::createFromImageData(stp.begin(), stp.size());
         }
         catch (std::exception &)
         {
-            g.setColour(juce::Colours::red);
-            g.fillRect(into);
         }
+        return res;
     }
 
-    dbIt = dbls.find(path);
-    if (dbIt != dbls.end())
+#if SST_JUCEGUI_PRECOMPILED_GLYPHS
+    static bool loadPrecompiled(const std::string &path, Entry &res)
     {
-        auto &svgDrawable = dbIt->second;
-        if (svgDrawable)
+        for (const auto &glyph : glyph_paths::glyphs)
         {
-            auto w = overW > 0 ? overW : svgDrawable->getWidth();
-            auto rw = into.getWidth();
-            auto h = overH > 0 ? overH : svgDrawable->getHeight();
-            auto rh = into.getHeight();
-
-            auto sf = std::min(1.0 * rw / w, 1.0 * rh / h);
+            if (path != glyph.resource)
+                continue;
+
+            res.found = true;
+            for (size_t i = 0; i < glyph.numLayers; ++i)
+            {
+                const auto &src = glyph.layers[i];
+                auto outline = juce::Path();
+                outline.loadPathFromData(src.path, src.pathSize);
+
+                auto &layer = res.layers.emplace_back();
+                if (src.fill)
+                    layer.fill = outline;
+                if (src.strokeWidth > 0)
+                    juce::PathStrokeType(src.strokeWidth,
+                                         (juce::PathStrokeType::JointStyle)src.strokeJoin,
+                                         (juce::PathStrokeType::EndCapStyle)src.strokeCap)
+                        .createStrokedPath(layer.stroke, outline);
+                if (src.clip)
+                {
+                    layer.clipped = true;
+                    layer.clip.loadPathFromData(src.clip, src.clipSize);
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+#endif
+};
+SvgGlyphCache *SvgGlyphCache::instance{nullptr};
 
-            svgDrawable->replaceColour(juce::Colour(baseColor), to);
-            svgDrawable->draw(
-                g, 1.0, juce::AffineTransform().scaled(sf).translated(into.getX(), into.getY()));
+/*
+ * Draws the SVG in its own colour. Glyph colour comes from tinting the mask this is
+ * rasterized into, so the shared drawable is never recoloured.
+ */
+void paintFromSvg(juce::Graphics &g, const juce::Rectangle<int> &into, const std::string &path,
+                  int overW, int overH)
+{
+    auto &entry = SvgGlyphCache::get().entryFor(path);
+    if (!entry.found)
+    {
+        g.setColour(juce::Colours::red);
+        g.fillRect(into);
+        return;
+    }
 
-            svgDrawable->replaceColour(to, juce::Colour(baseColor));
-        }
-        else
+    if (!entry.layers.empty())
+    {
+        auto sf = std::min(1.0 * into.getWidth() / overW, 1.0 * into.getHeight() / overH);
+        auto xf = juce::AffineTransform().scaled(sf).translated(into.getX(), into.getY());
+        for (const auto &layer : entry.layers)
         {
-            g.setColour(juce::Colours::orchid);
-            g.fillRect(into);
+            auto ss = juce::Graphics::ScopedSaveState(g);
+            if (layer.clipped)
+                g.reduceClipRegion(layer.clip, xf);
+            g.fillPath(layer.fill, xf);
+            g.fillPath(layer.stroke, xf);
         }
+        return;
+    }
+
+    auto &svgDrawable = entry.drawable;
+    if (svgDrawable)
+    {
+        auto w = overW > 0 ? overW : svgDrawable->getWidth();
+        auto rw = into.getWidth();
+        auto h = overH > 0 ? overH : svgDrawable->getHeight();
+        auto rh = into.getHeight();
+
+        auto sf = std::min(1.0 * rw / w, 1.0 * rh / h);
+
+        svgDrawable->draw(g, 1.0,
+                          juce::AffineTransform().scaled(sf).translated(into.getX(), into.getY()));
+    }
+    else
+    {
+        g.setColour(juce::Colours::orchid);
+        g.fillRect(into);
     }
 }
 
@@ -184,26 +290,20 @@ void paintPowerLight(juce::Graphics &g, const juce::Rectangle<int> &into, bool d
     }
 }
 
-void GlyphPainter::paint(juce::Graphics &g)
+struct SvgGlyph
 {
-    if (isEnabled())
-        paintGlyph(g, getLocalBounds(), glyph, getColour(Styles::labelcolor));
-    else
-        paintGlyph(g, getLocalBounds(), glyph, getColour(Styles::labelcolor).withAlpha(0.5f));
+    const char *path;
+    int size; // the square viewbox the glyph was drawn at
 };
 
-void GlyphPainter::paintGlyph(juce::Graphics &g, const juce::Rectangle<int> &into,
-                              sst::jucegui::components::GlyphPainter::GlyphType glyph,
-                              const juce::Colour &as)
+// Glyphs drawn from an SVG resource. They are all single colour shapes
+static std::optional<SvgGlyph> svgGlyphFor(GlyphPainter::GlyphType glyph)
 {
-    g.setColour(as);
     switch (glyph)
     {
-
 #define SVG24(k, s)                                                                                \
-    case k:                                                                                        \
-        paintFromSvg(g, into, "res/glyphs/" s ".svg", 0xFFAFAFAF, 24, 24, as);                     \
-        return;
+    case GlyphPainter::k:                                                                          \
+        return SvgGlyph{"res/glyphs/" s ".svg", 24};
 
         SVG24(METRONOME, "metronome");
         SVG24(PAN, "pan");
@@ -263,32 +363,94 @@ void GlyphPainter::paintGlyph(juce::Graphics &g, const juce::Rectangle<int> &int
         SVG24(FOLDER, "folder");
         SVG24(FILE_MUSIC, "file-music");
 
-    case SHOW_INFO:
-        paintFromSvg(g, into, "res/glyphs/show-info.svg", 0xFFAFAFAF, 16, 16, as);
+    case GlyphPainter::SHOW_INFO:
+        return SvgGlyph{"res/glyphs/show-info.svg", 16};
+#undef SVG24
+
+    default:
+        return std::nullopt;
+    }
+}
+
+/*
+ * Guards the SVG cache and the atlas below. Rasterizing happens under it too, since
+ * drawing a Drawable parsed from a non built-in resource isn't safe from two threads
+ * at once.
+ */
+static std::mutex &glyphCacheMutex()
+{
+    static std::mutex res;
+    return res;
+}
+
+void GlyphPainter::preloadAll()
+{
+    auto lock = std::lock_guard<std::mutex>(glyphCacheMutex());
+    for (int i = 0; i <= SHORTCIRCUIT_LOGO; ++i)
+    {
+        if (auto svg = svgGlyphFor((GlyphType)i))
+            SvgGlyphCache::get().entryFor(svg->path);
+    }
+}
+
+// Everything but the unknown-glyph pattern and the missing-resource fills is one colour
+static bool isSingleColour(GlyphPainter::GlyphType glyph)
+{
+    if (auto svg = svgGlyphFor(glyph))
+        return SvgGlyphCache::get().entryFor(svg->path).canDraw();
+
+    switch (glyph)
+    {
+    case GlyphPainter::KEYBOARD:
+    case GlyphPainter::MONO:
+    case GlyphPainter::STEREO:
+    case GlyphPainter::SMALL_POWER_LIGHT:
+    case GlyphPainter::SMALL_POWER_LIGHT_OFF:
+    case GlyphPainter::HAMBURGER:
+    case GlyphPainter::DICE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * The vector rendering of a glyph in the current colour, which the atlas rasterizes from.
+ * SVG glyphs read the shared cache, so call this with glyphCacheMutex held.
+ */
+static void paintGlyphShape(juce::Graphics &g, const juce::Rectangle<int> &into,
+                            GlyphPainter::GlyphType glyph)
+{
+    if (auto svg = svgGlyphFor(glyph))
+    {
+        paintFromSvg(g, into, svg->path, svg->size, svg->size);
         return;
+    }
 
-    case KEYBOARD:
+    switch (glyph)
+    {
+    case GlyphPainter::KEYBOARD:
         paintKeyboardGlyph(g, into);
         return;
 
-    case MONO:
+    case GlyphPainter::MONO:
         paintMonoGlyph(g, into);
         return;
 
-    case STEREO:
+    case GlyphPainter::STEREO:
         paintStereoGlyph(g, into);
         return;
 
-    case SMALL_POWER_LIGHT:
-    case SMALL_POWER_LIGHT_OFF:
-        paintPowerLight(g, into, glyph == SMALL_POWER_LIGHT);
+    case GlyphPainter::SMALL_POWER_LIGHT:
+    case GlyphPainter::SMALL_POWER_LIGHT_OFF:
+        paintPowerLight(g, into, glyph == GlyphPainter::SMALL_POWER_LIGHT);
         return;
 
-    case HAMBURGER:
+    case GlyphPainter::HAMBURGER:
         paintHamburger(g, into);
         return;
 
-    case DICE:
+    case GlyphPainter::DICE:
         paintDice(g, into);
         return;
 
@@ -304,7 +466,136 @@ void GlyphPainter::paintGlyph(juce::Graphics &g, const juce::Rectangle<int> &int
         return;
     }
     }
-    g.fillRect(into);
 }
 
-} // namespace sst::jucegui::components
\ No newline at end of file
+/*
+ * Glyphs rasterized once as alpha masks at device resolution, keyed by glyph, size and
+ * display scale, so a paint is a tinted blit rather than a vector render. The least
+ * recently used masks go once there are more than maxEntries, and a change of display
+ * scale drops the lot since masks at the old scale won't be asked for again. Only
+ * touched with glyphCacheMutex held.
+ */
+struct GlyphAtlas : juce::DeletedAtShutdown
+{
+    static constexpr size_t maxEntries{256};
+    static constexpr int maxMaskSize{512};
+
+    struct Key
+    {
+        GlyphPainter::GlyphType glyph;
+        int w, h;
+        bool operator==(const Key &other) const
+        {
+            return glyph == other.glyph && w == other.w && h == other.h;
+        }
+    };
+    struct KeyHash
+    {
+        size_t operator()(const Key &k) const
+        {
+            return ((size_t)k.glyph * 1000003u) ^ ((size_t)k.w << 16) ^ (size_t)k.h;
+        }
+    };
+
+    // most recently used at the front
+    std::list<std::pair<Key, juce::Image>> lru;
+    std::unordered_map<Key, decltype(lru)::iterator, KeyHash> index;
+    float scale{0.f};
+
+    static GlyphAtlas *instance;
+    static GlyphAtlas &get()
+    {
+        if (!instance)
+            instance = new GlyphAtlas();
+        return *instance;
+    }
+    ~GlyphAtlas() { instance = nullptr; }
+
+    // An invalid image means paint the vector shape directly
+    juce::Image maskFor(GlyphPainter::GlyphType glyph, int w, int h, float atScale)
+    {
+        if (atScale != scale)
+        {
+            lru.clear();
+            index.clear();
+            scale = atScale;
+        }
+
+        auto k = Key{glyph, w, h};
+        auto it = index.find(k);
+        if (it != index.end())
+        {
+            lru.splice(lru.begin(), lru, it->second);
+            return it->second->second;
+        }
+
+        auto pw = juce::roundToInt(w * scale);
+        auto ph = juce::roundToInt(h * scale);
+        if (pw <= 0 || ph <= 0 || !isSingleColour(glyph))
+            return {};
+
+        auto mask = juce::Image(juce::Image::SingleChannel, pw, ph, true);
+        {
+            auto mg = juce::Graphics(mask);
+            mg.addTransform(juce::AffineTransform::scale(scale));
+            mg.setColour(juce::Colours::white);
+            paintGlyphShape(mg, {0, 0, w, h}, glyph);
+        }
+
+        // big one-offs are tinted like the rest but not worth the atlas space
+        if (pw > maxMaskSize || ph > maxMaskSize)
+            return mask;
+
+        lru.emplace_front(k, mask);
+        index[k] = lru.begin();
+        if (lru.size() > maxEntries)
+        {
+            index.erase(lru.back().first);
+            lru.pop_back();
+        }
+        return mask;
+    }
+};
+GlyphAtlas *GlyphAtlas::instance{nullptr};
+
+void GlyphPainter::paint(juce::Graphics &g)
+{
+    if (isEnabled())
+        paintGlyph(g, getLocalBounds(), glyph, getColour(Styles::labelcolor), this);
+    else
+        paintGlyph(g, getLocalBounds(), glyph, getColour(Styles::labelcolor).withAlpha(0.5f),
+                   this);
+};
+
+void GlyphPainter::paintGlyph(juce::Graphics &g, const juce::Rectangle<int> &into,
+                              sst::jucegui::components::GlyphPainter::GlyphType glyph,
+                              const juce::Colour &as, const juce::Component *owner)
+{
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto mask = juce::Image();
+    {
+        auto lock = std::lock_guard<std::mutex>(glyphCacheMutex());
+        mask = GlyphAtlas::get().maskFor(glyph, into.getWidth(), into.getHeight(), scale);
+    }
+    if (mask.isValid())
+    {
+        // The mask is at device resolution, so map its pixels back down onto into. Its
+        // origin is snapped to a whole device pixel, since a blit between pixels resamples
+        auto origin = juce::Point<float>();
+        if (owner)
+            origin = owner->getTopLevelComponent()->getLocalPoint(owner, origin);
+        auto device = (origin + into.getPosition().toFloat()) * scale;
+        auto at = juce::Point<float>(std::round(device.x), std::round(device.y)) / scale - origin;
+        g.setColour(as);
+        g.drawImageTransformed(
+            mask, juce::AffineTransform::scale(1.f / scale).translated(at.x, at.y), true);
+        return;
+    }
+
+    // no mask (an empty rect, or a glyph which isn't one colour), so render it here
+    g.setColour(as);
+    auto lock = std::lock_guard<std::mutex>(glyphCacheMutex());
+    paintGlyphShape(g, into, glyph);
+}
+
+} // namespace sst::jucegui::components
@@ -16,6 +16,7 @@
  */
 
 #include <sst/jucegui/components/HSliderFilled.h>
+#include "SliderPainter.hxx"
 
 namespace sst::jucegui::components
 {
@@ -25,8 +26,25 @@ HSliderFilled::HSliderFilled()
     setShowValue(false);
 }
 
+juce::Rectangle<int> HSliderFilled::getValueBounds()
+{
+    if (!continuous())
+        return getLocalBounds();
+
+    // The handle is a two pixel bar across the gutter, centred half a pixel past the value
+    auto gutter = hSliderFilledGutter(this);
+    auto [lo, hi] = sliderValueSpan01(this);
+    auto x0 = gutter.getX() + lo * gutter.getWidth() - 2.f;
+    auto x1 = gutter.getX() + hi * gutter.getWidth() + 3.f;
+
+    auto res = gutter.withLeft(x0).withRight(x1).getSmallestIntegerContainer();
+    return res.getIntersection(getLocalBounds());
+}
+
 void HSliderFilled::paint(juce::Graphics &g)
 {
+    paintedValueBounds = getValueBounds();
+
     if (!continuous())
     {
         g.fillAll(juce::Colours::red);
@@ -38,14 +56,13 @@ void HSliderFilled::paint(juce::Graphics &g)
     if (continuous()->isHidden())
         return;
 
-    auto r = getLocalBounds().reduced(0, verticalReduction).toFloat();
     auto rectRad = 5;
 
     if (isHovered && isEnabled())
         g.setColour(getColour(Styles::gutter_hover));
     else
         g.setColour(getColour(Styles::gutter));
-    auto gutter = r.reduced(2).toFloat();
+    auto gutter = hSliderFilledGutter(this);
     g.fillRect(gutter);
 
     if (modulationDisplay == FROM_ACTIVE)
@@ -90,7 +90,7 @@ void JogUpDownButton::paint(juce::Graphics &g)
     {
         col = ar.withAlpha(0.5f);
     }
-    GlyphPainter::paintGlyph(g, lbb, GlyphPainter::GlyphType::JOG_LEFT, col);
+    GlyphPainter::paintGlyph(g, lbb, GlyphPainter::GlyphType::JOG_LEFT, col, this);
 
     auto rbb = rightButtonBound();
     col = rbb.contains(hoverX, getHeight() / 2) ? har : ar;
@@ -99,7 +99,7 @@ void JogUpDownButton::paint(juce::Graphics &g)
     {
         col = ar.withAlpha(0.5f);
     }
-    GlyphPainter::paintGlyph(g, rbb, GlyphPainter::GlyphType::JOG_RIGHT, col);
+    GlyphPainter::paintGlyph(g, rbb, GlyphPainter::GlyphType::JOG_RIGHT, col, this);
 }
 
 bool JogUpDownButton::isOverControl(const juce::Point<int> &e) const
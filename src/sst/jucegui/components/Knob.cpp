@@ -18,8 +18,135 @@
 #include <sst/jucegui/components/Knob.h>
 #include "KnobPainter.hxx"
 
+#include <list>
+#include <map>
+#include <unordered_map>
+
 namespace sst::jucegui::components
 {
+/*
+ * The static knob layers, least recently used dropped first. Message thread only, like
+ * the knob paints that fill it.
+ */
+struct KnobLayerCache : juce::DeletedAtShutdown
+{
+    static constexpr size_t maxEntries{128};
+    static constexpr int maxLayerSize{1024};
+
+    struct KeyHash
+    {
+        size_t operator()(const KnobLayerKey &k) const
+        {
+            auto h = std::hash<uint32_t>()(k.colour);
+            h = h * 31 + std::hash<float>()(k.scale);
+            h = h * 31 + (size_t)k.width;
+            h = h * 31 + (size_t)k.strokeWidth;
+            h = h * 31 + (size_t)(k.subX * KnobLayerKey::subPixelSteps + k.subY);
+            return h * 4 + (size_t)k.layer * 2 + (k.bipolarClip ? 1 : 0);
+        }
+    };
+
+    // most recently used at the front
+    std::list<std::pair<KnobLayerKey, juce::Image>> lru;
+    std::unordered_map<KnobLayerKey, decltype(lru)::iterator, KeyHash> index;
+
+    static bool enabled;
+    static KnobLayerCache *instance;
+    static KnobLayerCache &get()
+    {
+        if (!instance)
+            instance = new KnobLayerCache();
+        return *instance;
+    }
+    ~KnobLayerCache() { instance = nullptr; }
+};
+KnobLayerCache *KnobLayerCache::instance{nullptr};
+bool KnobLayerCache::enabled{true};
+
+void setKnobLayerCaching(bool enabled) { KnobLayerCache::enabled = enabled; }
+
+juce::Image cachedKnobLayer(const KnobLayerKey &key,
+                            const std::function<void(juce::Graphics &)> &paintLayer)
+{
+    if (!KnobLayerCache::enabled)
+        return {};
+
+    auto &cache = KnobLayerCache::get();
+    auto it = cache.index.find(key);
+    if (it != cache.index.end())
+    {
+        cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+        return it->second->second;
+    }
+
+    // a pixel larger, for the sub pixel offset
+    auto sz = (int)std::ceil(key.width * key.scale) + 1;
+    if (key.width <= 0 || sz > KnobLayerCache::maxLayerSize)
+        return {};
+
+    auto img = juce::Image(juce::Image::ARGB, sz, sz, true);
+    {
+        auto lg = juce::Graphics(img);
+        lg.addTransform(juce::AffineTransform::scale(key.scale).translated(
+            (float)key.subX / KnobLayerKey::subPixelSteps,
+            (float)key.subY / KnobLayerKey::subPixelSteps));
+        paintLayer(lg);
+    }
+
+    cache.lru.emplace_front(key, img);
+    cache.index[key] = cache.lru.begin();
+    if (cache.lru.size() > KnobLayerCache::maxEntries)
+    {
+        cache.index.erase(cache.lru.back().first);
+        cache.lru.pop_back();
+    }
+    return img;
+}
+
+/*
+ * The arc geometries by (width, stroke width), least recently used dropped first. Knobs
+ * come in a handful of sizes, but a resizable editor can ask for many over its life.
+ */
+struct KnobArcGeometryCache : juce::DeletedAtShutdown
+{
+    static constexpr size_t maxEntries{64};
+
+    // most recently used at the front
+    std::list<std::pair<std::pair<int, int>, KnobArcGeometry>> lru;
+    std::map<std::pair<int, int>, decltype(lru)::iterator> index;
+
+    static KnobArcGeometryCache *instance;
+    static KnobArcGeometryCache &get()
+    {
+        if (!instance)
+            instance = new KnobArcGeometryCache();
+        return *instance;
+    }
+    ~KnobArcGeometryCache() { instance = nullptr; }
+};
+KnobArcGeometryCache *KnobArcGeometryCache::instance{nullptr};
+
+const KnobArcGeometry &knobArcGeometry(int width, int strokeWidth)
+{
+    auto &cache = KnobArcGeometryCache::get();
+    auto key = std::make_pair(width, strokeWidth);
+    auto it = cache.index.find(key);
+    if (it != cache.index.end())
+    {
+        cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+        return it->second->second;
+    }
+
+    cache.lru.emplace_front(key, KnobArcGeometry(width, strokeWidth));
+    cache.index[key] = cache.lru.begin();
+    if (cache.lru.size() > KnobArcGeometryCache::maxEntries)
+    {
+        cache.index.erase(cache.lru.back().first);
+        cache.lru.pop_back();
+    }
+    return cache.lru.front().second;
+}
+
 template <typename T> KnobFor<T>::KnobFor() : style::StyleConsumer(Styles::styleClass), T() {}
 
 template <>
@@ -49,7 +176,7 @@ void Knob::paint(juce::Graphics &g)
             g.setColour(getColour(Styles::labelcolor_hover));
         else
             g.setColour(getColour(Styles::labelcolor));
-        g.setFont(getFont(Styles::labelfont));
+        g.setFont(getFontHandle(Styles::labelfont)->font);
         g.drawText(continuous()->getLabel(), textarea, juce::Justification::centred);
     }
 }
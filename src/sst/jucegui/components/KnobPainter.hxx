@@ -7,12 +7,201 @@
 
 #include <type_traits>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
 namespace sst::jucegui::components
 {
 
+/*
+ * The gutter ring and the knob body don't move with the value, so they are rendered
+ * once into device resolution images shared by every knob with the same geometry and
+ * colours. The key holds the resolved colours rather than a style generation, so a
+ * restyle, hover or disable just picks (or builds) a different layer. A paint then
+ * blits these and draws only the arcs and handle.
+ */
+struct KnobLayerKey
+{
+    enum Layer
+    {
+        GUTTER,
+        BODY
+    } layer;
+    int width, strokeWidth;
+    float scale;
+    bool bipolarClip;
+    uint32_t colour;
+    // where the knob's origin falls inside a device pixel, in subPixelSteps; set by
+    // drawKnobLayer
+    int subX{0}, subY{0};
+
+    static constexpr int subPixelSteps{8};
+
+    bool operator==(const KnobLayerKey &o) const
+    {
+        return layer == o.layer && width == o.width && strokeWidth == o.strokeWidth &&
+               scale == o.scale && bipolarClip == o.bipolarClip && colour == o.colour &&
+               subX == o.subX && subY == o.subY;
+    }
+};
+
+// Defined in Knob.cpp. Returns an invalid image if the layer is too large to be worth caching
+juce::Image cachedKnobLayer(const KnobLayerKey &key,
+                            const std::function<void(juce::Graphics &)> &paintLayer);
+// Defined in Knob.cpp. Turned off, layers are painted directly; for comparing against
+void setKnobLayerCaching(bool enabled);
+
+/*
+ * Where the painter's origin lands in device pixels. Graphics doesn't expose its
+ * transform, so this follows the widget up to its top level component, which is what
+ * a peer or paintEntireComponent draws from.
+ */
+template <typename T> juce::Point<float> knobDeviceOrigin(T *that, float scale)
+{
+    auto p = juce::Point<float>();
+    if constexpr (std::is_base_of_v<juce::Component, T>)
+        p = that->getTopLevelComponent()->getLocalPoint(that, p);
+    else
+        p = that->getPositionInTopLevel();
+    return p * scale;
+}
+
+/*
+ * Layers are rendered already offset to where the origin falls inside a device pixel and
+ * then blitted onto whole device pixels. A layer blitted at a fractional device offset (a
+ * knob at an odd position at 125%, say) would be resampled and blur.
+ */
+inline void drawKnobLayer(juce::Graphics &g, KnobLayerKey key, juce::Point<float> deviceOrigin,
+                          const std::function<void(juce::Graphics &)> &paintLayer)
+{
+    auto fx = deviceOrigin.x - std::floor(deviceOrigin.x);
+    auto fy = deviceOrigin.y - std::floor(deviceOrigin.y);
+    key.subX = juce::roundToInt(fx * KnobLayerKey::subPixelSteps);
+    key.subY = juce::roundToInt(fy * KnobLayerKey::subPixelSteps);
+
+    auto img = cachedKnobLayer(key, paintLayer);
+    if (img.isValid())
+        g.drawImageTransformed(
+            img, juce::AffineTransform::translation(-fx, -fy).scaled(1.f / key.scale));
+    else
+        paintLayer(g);
+}
+
+/*
+ * Every knob arc is a circular arc stroked with butt ends, which is an annular sector.
+ * This holds the ring for one (size, stroke width) along with a table of unit vectors
+ * round the circle, so a paint fills sector outlines built by indexing that table
+ * rather than building addArc paths and stroking them.
+ */
+struct KnobArcGeometry
+{
+    static constexpr int tableSize{256};
+    static constexpr float bipolarGap{1.5};
+    static constexpr float dPath{0.2};
+    static constexpr float dAng{juce::MathConstants<float>::pi * (1 - dPath)};
+    static constexpr float step{2 * juce::MathConstants<float>::pi / tableSize};
+
+    float centre, radius;
+    // half the width of the handle and bipolar gap, in 0..1 value units
+    float handleAng;
+    // index i is at angle i * step - pi, clockwise from twelve o'clock
+    std::array<juce::Point<float>, tableSize + 1> unit;
+
+    KnobArcGeometry(int width, int strokeWidth)
+    {
+        centre = width * 0.5f;
+        radius = std::max((width - strokeWidth - 2) * 0.5f, 0.f);
+
+        // we want an angle such that w/2 * sin(angle) = bipolarGap
+        handleAng =
+            asin(bipolarGap * 2 / width) * (1 - dPath) / (2 * juce::MathConstants<float>::pi);
+
+        for (int i = 0; i <= tableSize; ++i)
+        {
+            auto a = i * step - juce::MathConstants<float>::pi;
+            unit[i] = {std::sin(a), -std::cos(a)};
+        }
+    }
+
+    // Path::addCentredArc walks out from its start angle in steps of this many radians, so a
+    // stroke of it ends square to its first and last chords rather than to the radius.
+    static constexpr float addArcStep{0.05f};
+
+    // The outline of the arc between two values in 0...1, either way round, with its ends cut
+    // the way a stroked addArc would cut them.
+    juce::Path arc(float startV, float endV, float width) const
+    {
+        auto as = dAng * (2 * startV - 1);
+        auto ae = dAng * (2 * endV - 1);
+        auto span = std::fabs(ae - as);
+
+        auto p = juce::Path();
+        if (span <= 0 || width <= 0)
+            return p;
+
+        auto dir = ae > as ? 1.f : -1.f;
+        auto firstChord = std::min(addArcStep, span);
+        auto lastChord = span - (std::ceil(span / addArcStep) - 1) * addArcStep;
+
+        auto hw = width * 0.5f;
+        auto ro = radius + hw;
+        auto ri = std::max(radius - hw, 0.f);
+        auto onCircle = [this](float r, float a) {
+            return juce::Point<float>(centre + r * std::sin(a), centre - r * std::cos(a));
+        };
+        auto fromTable = [this](float r, int i) {
+            return juce::Point<float>(centre + r * unit[i].x, centre + r * unit[i].y);
+        };
+        // a corner of the end at angle a, square to the chord centred on angle mid
+        auto capAt = [&](float a, float mid, float out) {
+            return onCircle(radius, a) + juce::Point<float>(std::sin(mid), -std::cos(mid)) * out;
+        };
+        auto angleOf = [this](juce::Point<float> q) {
+            return std::atan2(q.x - centre, centre - q.y);
+        };
+
+        auto startMid = as + dir * firstChord * 0.5f;
+        auto endMid = ae - dir * lastChord * 0.5f;
+        auto o0 = capAt(as, startMid, hw), i0 = capAt(as, startMid, ri - radius);
+        auto o1 = capAt(ae, endMid, hw), i1 = capAt(ae, endMid, ri - radius);
+        if (dir < 0)
+        {
+            std::swap(o0, o1);
+            std::swap(i0, i1);
+        }
+
+        // the table entries strictly inside the arc, on each edge
+        auto pi = juce::MathConstants<float>::pi;
+        auto firstInside = [pi](float a) {
+            return std::clamp((int)std::floor((a + pi) / step) + 1, 0, tableSize + 1);
+        };
+        auto lastInside = [pi](float a) {
+            return std::clamp((int)std::ceil((a + pi) / step) - 1, -1, tableSize);
+        };
+        auto oFrom = firstInside(angleOf(o0)), oTo = lastInside(angleOf(o1));
+        auto iFrom = firstInside(angleOf(i0)), iTo = lastInside(angleOf(i1));
+
+        p.preallocateSpace(3 * (std::max(oTo - oFrom + 1, 0) + std::max(iTo - iFrom + 1, 0) + 5));
+        p.startNewSubPath(o0);
+        for (int i = oFrom; i <= oTo; ++i)
+            p.lineTo(fromTable(ro, i));
+        p.lineTo(o1);
+        p.lineTo(i1);
+        for (int i = iTo; i >= iFrom; --i)
+            p.lineTo(fromTable(ri, i));
+        p.lineTo(i0);
+        p.closeSubPath();
+        return p;
+    }
+};
+
+// Defined in Knob.cpp. The geometry for a knob of this width, built on first use. Only
+// good until the next call, which may drop it from the cache, so don't hold it past a paint
+const KnobArcGeometry &knobArcGeometry(int width, int strokeWidth);
+
 template <typename T, typename S> void knobPainterNoBody(juce::Graphics &g, T *that, S *source)
 {
     auto b = that->getLocalBounds();
@@ -20,49 +209,44 @@ template <typename T, typename S> void knobPainterNoBody(juce::Graphics &g, T *t
 
     int strokeWidth = that->style()->getKnobRingStrokeWidth(knobarea.getWidth());
 
-    //  start and end here are 0...1
-    auto arcFromTo = [knobarea, strokeWidth](float startV, float endV) {
-        float dPath = 0.2;
-        float dAng = juce::MathConstants<float>::pi * (1 - dPath);
-        float startA = dAng * (2 * startV - 1);
-        float endA = dAng * (2 * endV - 1);
+    const auto &geom = knobArcGeometry(knobarea.getWidth(), strokeWidth);
 
-        auto region = knobarea.toFloat().reduced(strokeWidth * 0.5 + 1);
-        auto p = juce::Path();
-        p.startNewSubPath(region.getCentre().toFloat());
-        p.addArc(region.getX(), region.getY(), region.getWidth(), region.getHeight(), startA, endA,
-                 true);
-        return p;
+    //  start and end here are 0...1
+    auto arcFromTo = [&geom, strokeWidth](float startV, float endV, float widthScale = 1.f) {
+        return geom.arc(startV, endV, strokeWidth * widthScale);
     };
 
     float dA = 1.f;
+    auto gutterColour = juce::Colour();
     if (!that->isEnabled())
     {
-        g.setColour(that->getColour(T::Styles::gutter).withAlpha(0.5f));
+        gutterColour = that->getColour(T::Styles::gutter).withAlpha(0.5f);
         dA = 0.3f;
     }
     else if (that->isHovered)
-        g.setColour(that->getColour(T::Styles::gutter_hover));
+        gutterColour = that->getColour(T::Styles::gutter_hover);
     else
-        g.setColour(that->getColour(T::Styles::gutter));
+        gutterColour = that->getColour(T::Styles::gutter);
 
     auto bipolarClip = source->isBipolar() && that->pathDrawMode == T::FOLLOW_BIPOLAR;
-    static constexpr float bipolarGap{1.5};
-    float dPath = 0.2;
-    // we want an angle such that w/2 * sin(angle) = bipolarGap
-    float handleAng =
-        asin(bipolarGap * 2 / b.getWidth()) * (1 - dPath) / (2 * juce::MathConstants<float>::pi);
+    auto handleAng = geom.handleAng;
 
     // This is where we draw the gutter.
-    if (bipolarClip)
-    {
-        g.strokePath(arcFromTo(0, 0.5 - handleAng), juce::PathStrokeType(strokeWidth));
-        g.strokePath(arcFromTo(0.5 + handleAng, 1), juce::PathStrokeType(strokeWidth));
-    }
-    else
-    {
-        g.strokePath(arcFromTo(0, 1), juce::PathStrokeType(strokeWidth));
-    }
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto gutterKey = KnobLayerKey{KnobLayerKey::GUTTER, knobarea.getWidth(), strokeWidth, scale,
+                                  bipolarClip, gutterColour.getARGB()};
+    drawKnobLayer(g, gutterKey, knobDeviceOrigin(that, scale), [&](juce::Graphics &lg) {
+        lg.setColour(gutterColour);
+        if (bipolarClip)
+        {
+            lg.fillPath(arcFromTo(0, 0.5 - handleAng));
+            lg.fillPath(arcFromTo(0.5 + handleAng, 1));
+        }
+        else
+        {
+            lg.fillPath(arcFromTo(0, 1));
+        }
+    });
 
     auto v = source->getValue01();
     float startV{0.f}, endV{v};
@@ -99,16 +283,16 @@ template <typename T, typename S> void knobPainterNoBody(juce::Graphics &g, T *t
     {
         if (startV < 0.5)
         {
-            g.strokePath(arcFromTo(startV, endV - handleAng), juce::PathStrokeType(strokeWidth));
+            g.fillPath(arcFromTo(startV, endV - handleAng));
         }
         else
         {
-            g.strokePath(arcFromTo(startV + handleAng, endV), juce::PathStrokeType(strokeWidth));
+            g.fillPath(arcFromTo(startV + handleAng, endV));
         }
     }
     else
     {
-        g.strokePath(arcFromTo(startV, endV), juce::PathStrokeType(strokeWidth));
+        g.fillPath(arcFromTo(startV, endV));
     }
 
     constexpr bool supportsMod = std::is_base_of_v<data::ContinuousModulatable, S>;
@@ -123,7 +307,7 @@ template <typename T, typename S> void knobPainterNoBody(juce::Graphics &g, T *t
             if (mstart > mend)
                 std::swap(mstart, mend);
             g.setColour(that->getColour(T::Styles::modulation_value));
-            g.strokePath(arcFromTo(mstart, mend), juce::PathStrokeType(strokeWidth * 0.7));
+            g.fillPath(arcFromTo(mstart, mend, 0.7f));
 
             if (source->isModulationBipolar())
             {
@@ -133,7 +317,7 @@ template <typename T, typename S> void knobPainterNoBody(juce::Graphics &g, T *t
                 if (mstart > mend)
                     std::swap(mstart, mend);
                 g.setColour(that->getColour(T::Styles::modulation_value));
-                g.strokePath(arcFromTo(mstart, mend), juce::PathStrokeType(strokeWidth * 0.7));
+                g.fillPath(arcFromTo(mstart, mend, 0.7f));
             }
         }
     }
@@ -143,7 +327,7 @@ template <typename T, typename S> void knobPainterNoBody(juce::Graphics &g, T *t
         auto v = source->getValue01();
 
         g.setColour(that->getColour(T::Styles::handle).withAlpha(dA));
-        g.strokePath(arcFromTo(v - handleAng, v + handleAng), juce::PathStrokeType(strokeWidth));
+        g.fillPath(arcFromTo(v - handleAng, v + handleAng));
     }
 }
 template <typename T, typename S> void knobPainter(juce::Graphics &g, T *that, S *source)
@@ -192,61 +376,66 @@ template <typename T, typename S> void knobPainter(juce::Graphics &g, T *that, S
         // Fill over the mess in the middle
         auto c = that->getColour(T::Styles::knobbase).withAlpha(dA);
 
-        g.saveState();
-        g.addTransform(juce::AffineTransform()
-                           .translated(-knobarea.getWidth() / 2, -knobarea.getHeight() / 2)
-                           .rotated(-0.3)
-                           .translated(knobarea.getWidth() / 2, knobarea.getHeight() / 2));
-
-        if (strokeWidth > 4)
-        {
-            auto pIn = circle(strokeWidth);
-            auto graded = juce::ColourGradient::vertical(c.brighter(0.2), knobarea.getY(),
-                                                         c.darker(0.3), knobarea.getBottom());
-            g.setGradientFill(graded);
-            // g.setColour(c);
-            g.fillPath(pIn);
-
-            graded = juce::ColourGradient::vertical(c.darker(0.15), knobarea.getY(),
-                                                    c.brighter(0.25), knobarea.getBottom());
-            auto pInIn = circle(strokeWidth + 3);
-            g.setGradientFill(graded);
-            // g.setColour(c);
-            g.fillPath(pInIn);
-
-            // Flat Style
-            g.setColour(c.darker(0.4));
-            g.strokePath(pIn, juce::PathStrokeType(1));
-        }
-        else
-        {
-            auto pIn = circle(strokeWidth);
-            g.setColour(c);
-            g.fillPath(pIn);
-        }
+        auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        auto bodyKey = KnobLayerKey{KnobLayerKey::BODY, knobarea.getWidth(), strokeWidth, scale,
+                                    false, c.getARGB()};
+        drawKnobLayer(g, bodyKey, knobDeviceOrigin(that, scale), [&](juce::Graphics &lg) {
+            lg.saveState();
+            lg.addTransform(juce::AffineTransform()
+                                .translated(-knobarea.getWidth() / 2, -knobarea.getHeight() / 2)
+                                .rotated(-0.3)
+                                .translated(knobarea.getWidth() / 2, knobarea.getHeight() / 2));
+
+            if (strokeWidth > 4)
+            {
+                auto pIn = circle(strokeWidth);
+                auto graded = juce::ColourGradient::vertical(c.brighter(0.2), knobarea.getY(),
+                                                             c.darker(0.3), knobarea.getBottom());
+                lg.setGradientFill(graded);
+                // lg.setColour(c);
+                lg.fillPath(pIn);
+
+                graded = juce::ColourGradient::vertical(c.darker(0.15), knobarea.getY(),
+                                                        c.brighter(0.25), knobarea.getBottom());
+                auto pInIn = circle(strokeWidth + 3);
+                lg.setGradientFill(graded);
+                // lg.setColour(c);
+                lg.fillPath(pInIn);
+
+                // Flat Style
+                lg.setColour(c.darker(0.4));
+                lg.strokePath(pIn, juce::PathStrokeType(1));
+            }
+            else
+            {
+                auto pIn = circle(strokeWidth);
+                lg.setColour(c);
+                lg.fillPath(pIn);
+            }
 
 #if 0
-        // Specular style
-        auto makeGrad = [c, knobarea](auto up, auto dn) {
-            return juce::ColourGradient::vertical(c.brighter(up), knobarea.getY(), c.darker(dn),
-                                                  knobarea.getY() + knobarea.getHeight());
-        };
-
-        g.setGradientFill(makeGrad(0.0, 0.5));
-        g.fillPath(pIn);
-        g.setColour(c.darker(0.6));
-        g.strokePath(pIn, juce::PathStrokeType(smallKnob ? 0.5 : 1.0));
-
-        pIn = circle(strokeWidth + 1);
-        g.setGradientFill(makeGrad(0.6, 0.35));
-        g.fillPath(pIn);
-
-        pIn = circle(strokeWidth + 2);
-        g.setGradientFill(makeGrad(0.1, 0.05));
-        g.fillPath(pIn);
+            // Specular style
+            auto makeGrad = [c, knobarea](auto up, auto dn) {
+                return juce::ColourGradient::vertical(c.brighter(up), knobarea.getY(), c.darker(dn),
+                                                      knobarea.getY() + knobarea.getHeight());
+            };
+
+            lg.setGradientFill(makeGrad(0.0, 0.5));
+            lg.fillPath(pIn);
+            lg.setColour(c.darker(0.6));
+            lg.strokePath(pIn, juce::PathStrokeType(smallKnob ? 0.5 : 1.0));
+
+            pIn = circle(strokeWidth + 1);
+            lg.setGradientFill(makeGrad(0.6, 0.35));
+            lg.fillPath(pIn);
+
+            pIn = circle(strokeWidth + 2);
+            lg.setGradientFill(makeGrad(0.1, 0.05));
+            lg.fillPath(pIn);
 #endif
 
-        g.restoreState();
+            lg.restoreState();
+        });
 
         g.saveState();
         g.addTransform(juce::AffineTransform()
@@ -116,7 +116,7 @@ void MultiSwitch::paint(juce::Graphics &g)
                         g.setColour(getColour(Styles::labelcolor).withAlpha(0.5f));
                 }
             }
-            g.setFont(getFont(Styles::labelfont));
+            g.setFont(getFontHandle(Styles::labelfont)->font);
             std::string ptxt{};
             auto abf = abbreviatedLabelMap.find(i + data->getMin());
             if (abf != abbreviatedLabelMap.end())
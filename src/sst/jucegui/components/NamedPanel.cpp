@@ -78,8 +78,8 @@ void NamedPanel::paint(juce::Graphics &g)
                       .reduced(outerMargin)
                       .withHeight(headerHeight)
                       .reduced(cornerRadius * 4, 0);
-        g.setFont(getFont(Styles::labelfont));
-        auto labelWidth = SST_STRING_WIDTH_INT(g.getCurrentFont(), name);
+        g.setFont(getFontHandle(Styles::labelfont)->font);
+        auto labelWidth = SST_STRING_WIDTH_INT(*getFontHandle(Styles::labelfont), name);
         g.setColour(bg);
         g.drawLine(b.getX() + 2 * cornerRadius, b.getY(), b.getX() + labelWidth + 6 * cornerRadius,
                    b.getY(), 1);
@@ -110,13 +110,13 @@ void NamedPanel::paintHeader(juce::Graphics &g)
 
             if (i == selectedTab)
             {
-                g.setFont(getFont(Styles::labelfont));
+                g.setFont(getFontHandle(Styles::labelfont)->font);
                 g.setColour(getColour(Styles::selectedtab));
                 g.drawText("[ " + s + " ]", p, juce::Justification::centred);
             }
             else
             {
-                g.setFont(getFont(Styles::labelfont));
+                g.setFont(getFontHandle(Styles::labelfont)->font);
                 g.setColour(getColour(Styles::labelcolor));
                 g.drawText(s, p, juce::Justification::centred);
             }
@@ -124,16 +124,16 @@ void NamedPanel::paintHeader(juce::Graphics &g)
     }
     else if (centeredHeader)
     {
-        g.setFont(getFont(Styles::labelfont));
+        g.setFont(getFontHandle(Styles::labelfont)->font);
         g.setColour(getColour(Styles::labelcolor));
         g.drawText(name, ht, juce::Justification::centred);
-        labelWidth = SST_STRING_WIDTH_INT(g.getCurrentFont(), name);
+        labelWidth = SST_STRING_WIDTH_INT(*getFontHandle(Styles::labelfont), name);
     }
     else
     {
-        g.setFont(getFont(Styles::labelfont));
+        g.setFont(getFontHandle(Styles::labelfont)->font);
         g.setColour(getColour(Styles::labelcolor));
-        labelWidth = SST_STRING_WIDTH_INT(g.getCurrentFont(), name);
+        labelWidth = SST_STRING_WIDTH_INT(*getFontHandle(Styles::labelfont), name);
         if (nameIsSelector)
         {
             auto pc = getColour(Styles::labelcolor);
@@ -142,7 +142,7 @@ void NamedPanel::paintHeader(juce::Graphics &g)
 
             auto gb = ht.withWidth(selectorWidth)
                           .translated(labelWidth, (ht.getHeight() - selectorWidth) / 2);
-            GlyphPainter::paintGlyph(g, gb.expanded(2), GlyphPainter::JOG_DOWN, pc);
+            GlyphPainter::paintGlyph(g, gb.expanded(2), GlyphPainter::JOG_DOWN, pc, this);
             g.setColour(pc);
             g.drawText(name, ht, juce::Justification::centredLeft);
             lastPaintedSelectorRegion = ht.withWidth(selectorWidth + labelWidth + 2);
@@ -373,7 +373,7 @@ void NamedPanel::activateOptionalCursorForNamedArea(bool b)
 
 void NamedPanel::resetTabState()
 {
-    auto f = getFont(Styles::labelfont);
+    auto f = getFontHandle(Styles::labelfont);
 
     auto b = getLocalBounds().reduced(outerMargin);
     auto ht = b.withHeight(headerHeight).reduced(4, 0); // the extra margin
@@ -382,7 +382,7 @@ void NamedPanel::resetTabState()
     tabPositions.clear();
     for (const auto &t : tabNames)
     {
-        auto fw = SST_STRING_WIDTH_INT(f, "[ " + t + " ]");
+        auto fw = SST_STRING_WIDTH_INT(*f, "[ " + t + " ]");
         auto tt = ht.withLeft(totalTabSize + 4).withWidth(fw);
         tabPositions.push_back(tt);
         totalTabSize += fw;
@@ -0,0 +1,731 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <sst/jucegui/components/ParameterBank.h>
+#include <sst/jucegui/components/HSlider.h>
+#include <sst/jucegui/components/VSlider.h>
+#include <sst/jucegui/accessibility/KeyboardTraverser.h>
+#include "ContinuousEdits.hxx"
+#include "KnobPainter.hxx"
+#include "SliderPainter.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sst::jucegui::components
+{
+ParameterBank::Cell::~Cell()
+{
+    if (continuous())
+        continuous()->removeGUIDataListener(this);
+}
+
+data::Continuous *ParameterBank::Cell::continuous()
+{
+    switch (source.index())
+    {
+    case 0:
+        return std::get<0>(source);
+    case 1:
+        return std::get<1>(source);
+    }
+    assert(false);
+    return nullptr;
+}
+
+data::ContinuousModulatable *ParameterBank::Cell::continuousModulatable()
+{
+    if (std::holds_alternative<data::ContinuousModulatable *>(source))
+        return std::get<data::ContinuousModulatable *>(source);
+    return nullptr;
+}
+
+void ParameterBank::Cell::dataChanged() { bank.repaintCell(index); }
+
+void ParameterBank::Cell::sourceVanished(data::Continuous *s)
+{
+    assert(s == continuous());
+    bank.dropValueWrite(index);
+    continuous()->removeGUIDataListener(this);
+    source = (data::ContinuousModulatable *)nullptr;
+    bank.repaintCell(index);
+}
+
+/*
+ * What the knob and slider painters expect of their widget, answered for one cell.
+ * The graphics origin is moved to the cell before painting, so local bounds are the
+ * cell bounds at zero, and colours resolve against the class of the widget W the cell
+ * stands in for.
+ */
+template <typename W> struct CellView
+{
+    using Styles = typename W::Styles;
+
+    using PathDrawMode = ParameterBank::PathDrawMode;
+    static constexpr PathDrawMode FOLLOW_BIPOLAR{Knob::FOLLOW_BIPOLAR};
+    static constexpr PathDrawMode ALWAYS_FROM_MIN{Knob::ALWAYS_FROM_MIN};
+    static constexpr PathDrawMode ALWAYS_FROM_MAX{Knob::ALWAYS_FROM_MAX};
+    static constexpr PathDrawMode ALWAYS_FROM_DEFAULT{Knob::ALWAYS_FROM_DEFAULT};
+
+    CellView(ParameterBank &b, ParameterBank::Cell &c, const style::StyleSheet::ptr_t &s)
+        : bank(b), cell(c), sheet(s), isHovered(b.getHoveredCell() == c.index),
+          isEditingMod(c.isEditingMod), modulationDisplay(c.modulationDisplay),
+          pathDrawMode(c.pathDrawMode)
+    {
+    }
+
+    ParameterBank &bank;
+    ParameterBank::Cell &cell;
+    const style::StyleSheet::ptr_t &sheet;
+
+    bool isHovered;
+    bool isEditingMod;
+    ParameterBank::ModulationDisplay modulationDisplay;
+    PathDrawMode pathDrawMode;
+
+    juce::Rectangle<int> getLocalBounds() const { return cell.bounds.withZeroOrigin(); }
+    juce::Point<float> getPositionInTopLevel() const
+    {
+        auto p = cell.bounds.getPosition().toFloat();
+        return bank.getTopLevelComponent()->getLocalPoint(&bank, p);
+    }
+    bool isEnabled() const { return cell.enabled && bank.isEnabled(); }
+    const style::StyleSheet::ptr_t &style() const { return sheet; }
+    juce::Colour getColour(const style::StyleSheet::Property &p) const
+    {
+        return sheet->getColour(Styles::styleClass, p);
+    }
+    style::FontHandle::ptr_t getFontHandle(const style::StyleSheet::Property &p) const
+    {
+        return sheet->getFontHandle(Styles::styleClass, p);
+    }
+    data::Continuous *continuous() { return cell.continuous(); }
+    data::ContinuousModulatable *continuousModulatable() { return cell.continuousModulatable(); }
+};
+
+/*
+ * The per cell accessibility presence. It takes keyboard focus and speaks for one cell
+ * but never sees the mouse; the bank underneath does all the drawing and hit testing.
+ */
+struct ParameterBankCellAccessible
+    : public juce::Component,
+      public sst::jucegui::accessibility::KeyboardTraverser::IssueIDIfMissingMarker
+{
+    ParameterBankCellAccessible(ParameterBank &b, int i) : bank(b), index(i)
+    {
+        setAccessible(true);
+        setWantsKeyboardFocus(true);
+        setInterceptsMouseClicks(false, false);
+    }
+
+    ParameterBank &bank;
+    const int index;
+
+    bool keyPressed(const juce::KeyPress &k) override { return bank.keyPressedOnCell(index, k); }
+    void focusGained(juce::Component::FocusChangeType cause) override
+    {
+        bank.setHoveredCell(index);
+    }
+    void focusLost(juce::Component::FocusChangeType cause) override
+    {
+        if (bank.getHoveredCell() == index)
+            bank.setHoveredCell(-1);
+    }
+
+    std::unique_ptr<juce::AccessibilityHandler> createAccessibilityHandler() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterBankCellAccessible)
+};
+
+struct ParameterBankCellAH : public juce::AccessibilityHandler
+{
+    struct CellValue : public juce::AccessibilityValueInterface
+    {
+        CellValue(ParameterBank &b, int i) : bank(b), index(i) {}
+
+        ParameterBank &bank;
+        const int index;
+
+        data::Continuous *continuous() const { return bank.getCell(index).continuous(); }
+
+        bool isReadOnly() const override { return false; }
+        double getCurrentValue() const override
+        {
+            if (!continuous())
+                return 0;
+            return continuous()->getValue();
+        }
+        void setValue(double newValue) override
+        {
+            if (!continuous())
+                return;
+
+            bank.beginEdit(index);
+            bank.setCellValueFromGUI(index, newValue);
+            bank.endEdit(index);
+        }
+        juce::String getCurrentValueAsString() const override
+        {
+            if (!continuous())
+                return "null";
+
+            return continuous()->getValueAsString();
+        }
+        void setValueAsString(const juce::String &newValue) override
+        {
+            if (!continuous())
+                return;
+
+            bank.beginEdit(index);
+            continuous()->setValueAsString(newValue.toStdString());
+            bank.notifyAccessibleChange(index);
+            bank.repaintCell(index);
+            bank.endEdit(index);
+        }
+        AccessibleValueRange getRange() const override
+        {
+            if (!continuous())
+                return {{0, 1}, 1};
+            return {{continuous()->getMin(), continuous()->getMax()},
+                    continuous()->getMinMaxRange() * 0.01};
+        }
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CellValue);
+    };
+
+    explicit ParameterBankCellAH(ParameterBankCellAccessible *c)
+        : juce::AccessibilityHandler(
+              *c, juce::AccessibilityRole::slider,
+              juce::AccessibilityActions().addAction(
+                  juce::AccessibilityActionType::showMenu,
+                  [c]() { c->bank.onPopupMenu(c->index, juce::ModifierKeys()); }),
+              AccessibilityHandler::Interfaces{std::make_unique<CellValue>(c->bank, c->index)})
+    {
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterBankCellAH);
+};
+
+std::unique_ptr<juce::AccessibilityHandler>
+ParameterBankCellAccessible::createAccessibilityHandler()
+{
+    return std::make_unique<ParameterBankCellAH>(this);
+}
+
+ParameterBank::ParameterBank() : style::StyleConsumer(ContinuousParamEditor::Styles::styleClass)
+{
+    setAccessible(true);
+    setTitle("Parameter Bank");
+}
+
+ParameterBank::~ParameterBank()
+{
+    // As in EditableComponentBase, a held write still goes out but an open wheel edit
+    // gets no onEndEdit; endWheelEditIfHidden has normally closed it already
+    flushValueWrite();
+    wheelEditCell = -1;
+    valueEmissionTimer.reset();
+
+    // The proxies reach back into the cells, so they go first
+    accessibleCells.clear();
+    cells.clear();
+}
+
+template <typename S>
+int ParameterBank::addCellFor(CellKind kind, S *source, const juce::Rectangle<int> &bounds)
+{
+    auto index = (int)cells.size();
+    auto cell = std::make_unique<Cell>(*this, index, kind);
+    cell->bounds = bounds;
+    cell->source = source;
+
+    auto acc = std::make_unique<ParameterBankCellAccessible>(*this, index);
+    acc->setBounds(bounds);
+    if (source)
+    {
+        source->addGUIDataListener(cell.get());
+        acc->setTitle(source->getLabel());
+    }
+    addAndMakeVisible(*acc);
+
+    cells.push_back(std::move(cell));
+    accessibleCells.push_back(std::move(acc));
+    repaint(bounds);
+    return index;
+}
+
+int ParameterBank::addCell(CellKind kind, data::Continuous *source,
+                           const juce::Rectangle<int> &bounds)
+{
+    return addCellFor(kind, source, bounds);
+}
+
+int ParameterBank::addCell(CellKind kind, data::ContinuousModulatable *source,
+                           const juce::Rectangle<int> &bounds)
+{
+    return addCellFor(kind, source, bounds);
+}
+
+void ParameterBank::clearCells()
+{
+    flushValueWrite();
+    if (wheelEditCell >= 0)
+        endEdit(wheelEditCell);
+
+    accessibleCells.clear();
+    cells.clear();
+    hoveredCell = -1;
+    dragCell = -1;
+    mouseMode = NONE;
+    repaint();
+}
+
+void ParameterBank::repaintCell(int index)
+{
+    if (index >= 0 && index < (int)cells.size())
+        repaint(cells[index]->bounds);
+}
+
+void ParameterBank::setCellBounds(int index, const juce::Rectangle<int> &bounds)
+{
+    repaintCell(index);
+    cells[index]->bounds = bounds;
+    accessibleCells[index]->setBounds(bounds);
+    repaintCell(index);
+}
+
+void ParameterBank::setCellEnabled(int index, bool b)
+{
+    cells[index]->enabled = b;
+    repaintCell(index);
+}
+
+void ParameterBank::setModulationDisplay(int index, ModulationDisplay d)
+{
+    cells[index]->modulationDisplay = d;
+    repaintCell(index);
+}
+
+void ParameterBank::setEditingModulation(int index, bool b)
+{
+    cells[index]->isEditingMod = b;
+    repaintCell(index);
+}
+
+int ParameterBank::cellAt(const juce::Point<float> &p) const
+{
+    // later cells paint over earlier ones, so they win the hit test too
+    for (auto i = (int)cells.size() - 1; i >= 0; --i)
+    {
+        if (cells[i]->bounds.toFloat().contains(p))
+            return i;
+    }
+    return -1;
+}
+
+static void paintKnobCell(juce::Graphics &g, CellView<Knob> &v)
+{
+    auto &cell = v.cell;
+    if (cell.continuousModulatable())
+        knobPainter(g, &v, cell.continuousModulatable());
+    else
+        knobPainter(g, &v, cell.continuous());
+
+    if (cell.drawLabel && cell.continuous())
+    {
+        auto b = v.getLocalBounds();
+        auto textarea = b.withTrimmedTop(b.getWidth());
+        if (v.isHovered)
+            g.setColour(v.getColour(Knob::Styles::labelcolor_hover));
+        else
+            g.setColour(v.getColour(Knob::Styles::labelcolor));
+        g.setFont(v.getFontHandle(Knob::Styles::labelfont)->font);
+        g.drawText(cell.continuous()->getLabel(), textarea, juce::Justification::centred);
+    }
+}
+
+void ParameterBank::paint(juce::Graphics &g)
+{
+    const auto &sheet = style();
+    if (!sheet)
+        return;
+
+    auto clip = g.getClipBounds();
+    for (auto &c : cells)
+    {
+        if (!c->bounds.intersects(clip))
+            continue;
+
+        juce::Graphics::ScopedSaveState gs(g);
+        g.reduceClipRegion(c->bounds);
+        g.setOrigin(c->bounds.getPosition());
+
+        switch (c->kind)
+        {
+        case KNOB:
+        {
+            auto v = CellView<Knob>(*this, *c, sheet);
+            paintKnobCell(g, v);
+        }
+        break;
+        case HSLIDER:
+        {
+            auto v = CellView<HSlider>(*this, *c, sheet);
+            hSliderPainter(g, &v, c->showLabel, c->showValue);
+        }
+        break;
+        case VSLIDER:
+        {
+            auto v = CellView<VSlider>(*this, *c, sheet);
+            vSliderPainter(g, &v);
+        }
+        break;
+        }
+    }
+}
+
+bool ParameterBank::processMouseActions(int index)
+{
+    if (index < 0 || index >= (int)cells.size())
+        return false;
+    auto *c = cells[index]->continuous();
+    if (!c)
+        return false;
+    if (c->isHidden())
+        return false;
+    if (!cells[index]->enabled)
+        return false;
+
+    return true;
+}
+
+void ParameterBank::setHoveredCell(int index)
+{
+    if (index == hoveredCell)
+        return;
+    repaintCell(hoveredCell);
+    hoveredCell = index;
+    repaintCell(hoveredCell);
+}
+
+void ParameterBank::setCellValueFromGUI(int index, float value)
+{
+    cells[index]->continuous()->setValueFromGUI(value);
+    notifyAccessibleChange(index);
+    repaintCell(index);
+}
+
+void ParameterBank::notifyAccessibleChange(int index)
+{
+    if (auto h = accessibleCells[index]->getAccessibilityHandler())
+    {
+        h->notifyAccessibilityEvent(juce::AccessibilityEvent::valueChanged);
+    }
+}
+
+void ParameterBank::mouseMove(const juce::MouseEvent &e) { setHoveredCell(cellAt(e.position)); }
+
+void ParameterBank::mouseExit(const juce::MouseEvent &e)
+{
+    if (mouseMode != DRAG)
+        setHoveredCell(-1);
+}
+
+void ParameterBank::mouseDown(const juce::MouseEvent &e)
+{
+    auto index = cellAt(e.position);
+    if (!processMouseActions(index))
+        return;
+
+    auto &cell = *cells[index];
+    dragCell = index;
+    setHoveredCell(index);
+
+    if (e.mods.isPopupMenu())
+    {
+        mouseMode = POPUP;
+        onPopupMenu(index, e.mods);
+        return;
+    }
+
+    mouseMode = DRAG;
+    beginEdit(index);
+    mouseDownV0 = getEditedValue(index);
+    mouseDownY0 = e.position.y;
+    mouseDownX0 = e.position.x;
+}
+
+void ParameterBank::mouseUp(const juce::MouseEvent &e)
+{
+    if (mouseMode == DRAG && processMouseActions(dragCell))
+        endEdit(dragCell);
+    mouseMode = NONE;
+    dragCell = -1;
+
+    setHoveredCell(cellAt(e.position));
+}
+
+void ParameterBank::mouseDoubleClick(const juce::MouseEvent &e)
+{
+    auto index = cellAt(e.position);
+    if (!processMouseActions(index))
+        return;
+
+    beginEdit(index);
+    setCellValueFromGUI(index, cells[index]->continuous()->getDefaultValue());
+    endEdit(index);
+}
+
+void ParameterBank::mouseDrag(const juce::MouseEvent &e)
+{
+    if (mouseMode != DRAG || !processMouseActions(dragCell))
+        return;
+
+    auto &cell = *cells[dragCell];
+    auto *cont = cell.continuous();
+    auto *mod = cell.isEditingMod ? cell.continuousModulatable() : nullptr;
+
+    auto d = continuousDragDelta(cont, mod, cell.kind != HSLIDER, (float)cell.bounds.getWidth(),
+                                 e.position.x - mouseDownX0, -(e.position.y - mouseDownY0),
+                                 getSetting(style::Settings::dragSensitivity), e.mods);
+    auto [lo, hi] = continuousEditRange(cont, mod);
+    auto vn = std::clamp(mouseDownV0 + d, lo, hi);
+    emitValueWrite(dragCell, vn, !mod && (e.mods.isCommandDown() || cell.alwaysQuantize));
+    if (!mod)
+        notifyAccessibleChange(dragCell);
+    mouseDownV0 = vn;
+    mouseDownX0 = e.position.x;
+    mouseDownY0 = e.position.y;
+
+    repaintCell(dragCell);
+}
+
+void ParameterBank::mouseWheelMove(const juce::MouseEvent &e, const juce::MouseWheelDetails &wheel)
+{
+    auto index = cellAt(e.position);
+    if (!processMouseActions(index))
+        return;
+
+    auto movement = continuousWheelMovement(e, wheel);
+    if (movement == 0)
+        return;
+
+    auto &cell = *cells[index];
+    auto *cont = cell.continuous();
+    auto *mod = cell.isEditingMod ? cell.continuousModulatable() : nullptr;
+
+    beginWheelEdit(index);
+    auto quantized = !mod && (e.mods.isCommandDown() || cell.alwaysQuantize);
+    auto d = continuousWheelDelta(cont, mod, movement, getSetting(style::Settings::wheelScaling),
+                                  quantized, e.mods);
+    auto [lo, hi] = continuousEditRange(cont, mod);
+    emitValueWrite(index, std::clamp(getEditedValue(index) + d, lo, hi), quantized);
+    if (!mod)
+        notifyAccessibleChange(index);
+    endWheelEdit(index);
+
+    onWheelEditOccurred(index);
+
+    repaintCell(index);
+}
+
+bool ParameterBank::keyPressedOnCell(int index, const juce::KeyPress &k)
+{
+    auto a = accessibleEdit(k);
+
+    using act = sst::jucegui::accessibility::AccessibilityKeyboardEditSupport<ParameterBank>;
+
+    if (a.isNone() || !processMouseActions(index))
+        return false;
+
+    auto *cont = cells[index]->continuous();
+    auto setTo = [this, index](float v) {
+        beginEdit(index);
+        setCellValueFromGUI(index, v);
+        endEdit(index);
+    };
+
+    switch (a.action)
+    {
+    case act::Action::ToMax:
+        setTo(cont->getMax());
+        return true;
+    case act::Action::ToMin:
+        setTo(cont->getMin());
+        return true;
+    case act::Action::ToDefault:
+        setTo(cont->getDefaultValue());
+        return true;
+    case act::Action::Increase:
+    case act::Action::Decrease:
+        // begin first, so a held wheel write lands before we step from the value
+        beginEdit(index);
+        setCellValueFromGUI(index, continuousKeyStep(cont, cont->getValue(),
+                                                     a.action == act::Action::Increase,
+                                                     a.mod == act::Action::Fine,
+                                                     a.mod == act::Action::Quantized ||
+                                                         cells[index]->alwaysQuantize));
+        endEdit(index);
+        return true;
+    case act::Action::OpenMenu:
+        onPopupMenu(index, juce::ModifierKeys());
+        return true;
+    default:
+        // There is no per cell type-in overlay; a bank client can offer one from the menu
+        break;
+    }
+    return false;
+}
+
+void ParameterBank::setValueEmissionRateHz(int hz)
+{
+    flushValueWrite();
+    valueEmissionRateHz = hz;
+    if (hz <= 0)
+    {
+        if (wheelEditCell >= 0)
+            endEdit(wheelEditCell);
+        valueEmissionTimer.reset();
+    }
+    else if (!valueEmissionTimer)
+    {
+        valueEmissionTimer = std::make_unique<ValueEmissionTimer>(*this);
+    }
+    else if (valueEmissionTimer->isTimerRunning())
+    {
+        valueEmissionTimer->startTimerHz(hz);
+    }
+}
+
+void ParameterBank::beginEdit(int index)
+{
+    if (wheelEditCell >= 0)
+        endEdit(wheelEditCell);
+    onBeginEdit(index);
+}
+
+void ParameterBank::endEdit(int index)
+{
+    flushValueWrite();
+    wheelEditCell = -1;
+    onEndEdit(index);
+}
+
+// Wheel events begin and end an edit each, unless coalescing joins them into one
+void ParameterBank::beginWheelEdit(int index)
+{
+    if (wheelEditCell == index)
+        return;
+    beginEdit(index);
+    if (!isCoalescingValueEmission())
+        return;
+    wheelEditCell = index;
+    if (!wheelEditVisibilityWatcher)
+        wheelEditVisibilityWatcher = std::make_unique<util::VisibilityParentWatcher>(this);
+}
+
+void ParameterBank::endWheelEdit(int index)
+{
+    if (wheelEditCell != index)
+        endEdit(index);
+}
+
+void ParameterBank::emitValueWrite(int index, float value, bool quantized)
+{
+    auto &cell = *cells[index];
+    auto write = std::function<void()>();
+    if (cell.isEditingMod && cell.continuousModulatable())
+        write = [m = cell.continuousModulatable(), value]() { m->setModulationValuePM1(value); };
+    else
+        write = [c = cell.continuous(), value, quantized]() {
+            if (quantized)
+                c->setValueFromGUIQuantized(value);
+            else
+                c->setValueFromGUI(value);
+        };
+
+    if (!isCoalescingValueEmission())
+    {
+        write();
+        return;
+    }
+    if (pendingWriteCell != index)
+        flushValueWrite();
+    heldValue = value;
+    pendingWriteCell = index;
+    pendingValueWrite = std::move(write);
+    if (!valueEmissionTimer->isTimerRunning())
+    {
+        flushValueWrite();
+        valueEmissionTimer->startTimerHz(valueEmissionRateHz);
+    }
+}
+
+void ParameterBank::flushValueWrite()
+{
+    if (!pendingValueWrite)
+        return;
+    auto w = std::move(pendingValueWrite);
+    pendingValueWrite = nullptr;
+    pendingWriteCell = -1;
+    w();
+}
+
+void ParameterBank::dropValueWrite(int index)
+{
+    if (pendingWriteCell != index)
+        return;
+    pendingValueWrite = nullptr;
+    pendingWriteCell = -1;
+}
+
+float ParameterBank::getEditedValue(int index)
+{
+    auto &cell = *cells[index];
+    if (pendingValueWrite && pendingWriteCell == index)
+        return heldValue;
+    if (cell.isEditingMod && cell.continuousModulatable())
+        return cell.continuousModulatable()->getModulationValuePM1();
+    return cell.continuous()->getValue();
+}
+
+void ParameterBank::ValueEmissionTimer::timerCallback()
+{
+    if (bank.pendingValueWrite)
+    {
+        bank.flushValueWrite();
+        return;
+    }
+    // a quiet period, so the burst is over
+    stopTimer();
+    if (bank.wheelEditCell >= 0)
+        bank.endEdit(bank.wheelEditCell);
+}
+
+// A wheel edit left open on a bank which stops showing would otherwise wait for the timer,
+// or for the destructor, which can't end it
+void ParameterBank::endWheelEditIfHidden()
+{
+    if (wheelEditCell >= 0 && !isShowing())
+        endEdit(wheelEditCell);
+}
+
+void ParameterBank::visibilityChanged() { endWheelEditIfHidden(); }
+
+void ParameterBank::parentHierarchyChanged() { endWheelEditIfHidden(); }
+
+} // namespace sst::jucegui::components
@@ -0,0 +1,441 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#ifndef INCLUDE_SST_JUCEGUI_COMPONENTS_SLIDERPAINTER_HXX
+#define INCLUDE_SST_JUCEGUI_COMPONENTS_SLIDERPAINTER_HXX
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <sst/jucegui/components/ContinuousParamEditor.h>
+
+namespace sst::jucegui::components
+{
+/*
+ * The gutters the handles run along. The paints and the value bounds below both use
+ * these so a partial repaint covers exactly what the paint moves.
+ */
+template <typename T>
+juce::Rectangle<float> hSliderGutter(T *that, bool showLabel, bool showValue)
+{
+    auto gutterheight = that->style()->getSliderGutterWidth();
+    auto hanRadius = that->style()->getSliderHandleRadius();
+
+    bool vCenter = !showLabel && !showValue;
+
+    auto b = that->getLocalBounds();
+    auto o = b.getHeight() - gutterheight;
+
+    auto r = b.withTrimmedTop(o * 0.5)
+                 .withTrimmedBottom(o * 0.5)
+                 .withTrimmedLeft(hanRadius + 2)
+                 .withTrimmedRight(hanRadius + 2)
+                 .toFloat();
+
+    if (!vCenter)
+    {
+        auto newY = hanRadius + 2;
+        if (r.getY() > newY)
+            r = r.withY(newY);
+    }
+    return r.reduced(1).toFloat();
+}
+
+template <typename T> juce::Rectangle<float> vSliderGutter(T *that)
+{
+    auto gutterwidth = that->style()->getSliderGutterWidth();
+    auto hanRadius = that->style()->getSliderHandleRadius();
+
+    auto b = that->getLocalBounds();
+    auto o = b.getWidth() - gutterwidth;
+    auto r = b.withTrimmedRight(o * 0.5)
+                 .withTrimmedLeft(o * 0.5)
+                 .withTrimmedTop(hanRadius + 2)
+                 .withTrimmedBottom(hanRadius + 2)
+                 .toFloat();
+    return r.reduced(1).toFloat();
+}
+
+// HSliderFilled's gutter fills the slider, less its vertical reduction and a margin
+template <typename T> juce::Rectangle<float> hSliderFilledGutter(T *that)
+{
+    return that->getLocalBounds().reduced(0, that->verticalReduction).toFloat().reduced(2);
+}
+
+/*
+ * The positions along the gutter (0..1) a value change moves: the value handle and, when
+ * editing modulation, the ends of the modulation rules. The value bar only changes
+ * between the old and new handle, so this span covers it too.
+ */
+template <typename T> std::pair<float, float> sliderValueSpan01(T *that)
+{
+    auto v = that->continuous()->getValue01();
+    auto lo = v, hi = v;
+    if (that->isEditingMod && that->continuousModulatable())
+    {
+        auto mv = that->continuousModulatable()->getModulationValuePM1();
+        lo = std::min(lo, std::clamp(v + mv, 0.f, 1.f));
+        hi = std::max(hi, std::clamp(v + mv, 0.f, 1.f));
+        if (that->continuousModulatable()->isModulationBipolar())
+        {
+            lo = std::min(lo, std::clamp(v - mv, 0.f, 1.f));
+            hi = std::max(hi, std::clamp(v - mv, 0.f, 1.f));
+        }
+    }
+    return {lo, hi};
+}
+
+/*
+ * The region of a slider which moves with its value, in local coordinates: the handles
+ * and modulation rules across the gutter, plus the value text when it is shown.
+ */
+template <typename T>
+juce::Rectangle<int> hSliderValueBounds(T *that, bool showLabel, bool showValue)
+{
+    if (!that->continuous() || !that->style())
+        return that->getLocalBounds();
+
+    auto gutter = hSliderGutter(that, showLabel, showValue);
+    auto hanRadius = that->style()->getSliderHandleRadius();
+    auto [lo, hi] = sliderValueSpan01(that);
+
+    // the handle centres sit half a pixel in from the value position; the outline and
+    // antialiasing add a pixel or two beyond the radius
+    auto pad = hanRadius + 2.f;
+    auto x0 = gutter.getX() + lo * gutter.getWidth() + 0.5f - pad;
+    auto x1 = gutter.getX() + hi * gutter.getWidth() + 0.5f + pad;
+    auto cy = gutter.getCentreY();
+    auto y0 = std::min(gutter.getY(), cy - pad);
+    auto y1 = std::max(gutter.getBottom(), cy + pad);
+
+    auto res = juce::Rectangle<float>::leftTopRightBottom(x0, y0, x1, y1)
+                   .getSmallestIntegerContainer();
+
+    if (showValue)
+    {
+        auto fh = that->getFontHandle(T::Styles::labelfont);
+        auto tw = SST_STRING_WIDTH_FLOAT(fh->font, that->continuous()->getValueAsString());
+        auto tb = that->getLocalBounds().reduced(2, 1);
+        res = res.getUnion(tb.removeFromRight((int)std::ceil(tw) + 2));
+    }
+    return res.getIntersection(that->getLocalBounds());
+}
+
+template <typename T> juce::Rectangle<int> vSliderValueBounds(T *that)
+{
+    if (!that->continuous() || !that->style())
+        return that->getLocalBounds();
+
+    auto gutter = vSliderGutter(that);
+    auto hanRadius = that->style()->getSliderHandleRadius();
+    auto [lo, hi] = sliderValueSpan01(that);
+
+    auto pad = hanRadius + 2.f;
+    auto y0 = gutter.getY() + (1 - hi) * gutter.getHeight() + 0.5f - pad;
+    auto y1 = gutter.getY() + (1 - lo) * gutter.getHeight() + 0.5f + pad;
+    auto cx = gutter.getCentreX();
+    auto x0 = std::min(gutter.getX(), cx - pad);
+    auto x1 = std::max(gutter.getRight(), cx + pad);
+
+    auto res = juce::Rectangle<float>::leftTopRightBottom(x0, y0, x1, y1)
+                   .getSmallestIntegerContainer();
+    return res.getIntersection(that->getLocalBounds());
+}
+
+/*
+ * The slider paints, written against anything which looks enough like a slider (a source,
+ * a style, hover and modulation state and local bounds) so that HSlider, VSlider and the
+ * ParameterBank cells draw through the same code.
+ */
+template <typename T>
+void hSliderPainter(juce::Graphics &g, T *that, bool showLabel, bool showValue)
+{
+    if (!that->continuous())
+    {
+        g.fillAll(juce::Colours::red);
+        g.setColour(juce::Colours::white);
+        g.drawText("NoSource", that->getLocalBounds(), juce::Justification::centred);
+        return;
+    }
+
+    if (that->continuous()->isHidden())
+        return;
+
+    auto gutterheight = that->style()->getSliderGutterWidth();
+    auto hanRadius = that->style()->getSliderHandleRadius();
+
+    if (showLabel)
+    {
+        if (that->isHovered)
+            g.setColour(that->getColour(T::Styles::labelcolor_hover));
+        else
+            g.setColour(that->getColour(T::Styles::labelcolor));
+        g.setFont(that->getFontHandle(T::Styles::labelfont)->font);
+        g.drawText(that->continuous()->getLabel(), that->getLocalBounds().reduced(2, 1),
+                   juce::Justification::bottomLeft);
+    }
+    if (showValue)
+    {
+        if (that->isHovered)
+            g.setColour(that->getColour(T::Styles::labelcolor_hover));
+        else
+            g.setColour(that->getColour(T::Styles::labelcolor));
+
+        g.setFont(that->getFontHandle(T::Styles::labelfont)->font);
+        g.drawText(that->continuous()->getValueAsString(), that->getLocalBounds().reduced(2, 1),
+                   juce::Justification::bottomRight);
+    }
+
+    // Gutter
+    if (that->isHovered)
+        g.setColour(that->getColour(T::Styles::gutter_hover));
+    else
+        g.setColour(that->getColour(T::Styles::gutter));
+    auto gutter = hSliderGutter(that, showLabel, showValue);
+    g.fillRoundedRectangle(gutter, gutterheight * 0.25);
+
+    if (that->modulationDisplay == ContinuousParamEditor::FROM_ACTIVE)
+    {
+        g.setColour(that->getColour(T::Styles::modulated_by_selected));
+        g.fillRoundedRectangle(gutter.reduced(2), gutterheight * 0.25);
+    }
+    else if (that->modulationDisplay == ContinuousParamEditor::FROM_OTHER)
+    {
+        g.setColour(that->getColour(T::Styles::modulated_by_other));
+        g.fillRoundedRectangle(gutter.reduced(2), gutterheight * 0.25);
+    }
+
+    auto v = that->continuous()->getValue01();
+    auto w = (1 - v) * gutter.getWidth();
+    auto hc = gutter.withTrimmedLeft(gutter.getWidth() - w).withWidth(1).expanded(0, 4).getCentre();
+
+    if (that->continuous()->isBipolar())
+    {
+        auto t = hc.getX();
+        auto b = gutter.getWidth() / 2 + gutter.getX();
+        if (t > b)
+            std::swap(t, b);
+        auto val = gutter.withLeft(t).withRight(b);
+        if (that->isHovered)
+            g.setColour(that->getColour(T::Styles::value_hover));
+        else
+            g.setColour(that->getColour(T::Styles::value));
+        g.fillRoundedRectangle(val, gutterheight * 0.25);
+    }
+    else
+    {
+        auto val = gutter.withTrimmedRight(w);
+        if (that->isHovered)
+            g.setColour(that->getColour(T::Styles::value_hover));
+        else
+            g.setColour(that->getColour(T::Styles::value));
+        g.fillRoundedRectangle(val, gutterheight * 0.25);
+    }
+
+    auto hr = juce::Rectangle<float>(2 * hanRadius, 2 * hanRadius).withCentre(hc);
+
+    juce::Point<float> mpc{};
+    juce::Rectangle<float> mpr{};
+    if (that->isEditingMod && that->continuousModulatable())
+    {
+        auto mvplus =
+            std::clamp(v + that->continuousModulatable()->getModulationValuePM1(), 0.f, 1.f);
+        auto mvminus =
+            std::clamp(v - that->continuousModulatable()->getModulationValuePM1(), 0.f, 1.f);
+        auto hm = (1.0 - mvplus) * gutter.getWidth();
+        mpc =
+            gutter.withTrimmedLeft(gutter.getWidth() - hm).withWidth(1).expanded(0, 4).getCentre();
+        mpr = juce::Rectangle<float>(2 * hanRadius, 2 * hanRadius).withCentre(mpc);
+
+        auto modvalcol = that->getColour(T::Styles::modulation_value);
+        if (that->isHovered)
+            modvalcol = that->getColour(T::Styles::modulation_value_hover);
+
+        auto modvaloppcol = that->getColour(T::Styles::modulation_opposite_value);
+        if (that->isHovered)
+            modvaloppcol = that->getColour(T::Styles::modulation_opposite_value_hover);
+
+        // draw rules
+        {
+            auto t = hc.getX();
+            auto b = (mvplus)*gutter.getWidth() + gutter.getX();
+            if (t > b)
+                std::swap(t, b);
+            auto val = gutter.withLeft(t).withRight(b);
+            g.setColour(modvalcol);
+            g.fillRoundedRectangle(val, gutterheight * 0.25);
+        }
+
+        if (that->continuousModulatable()->isModulationBipolar())
+        {
+            auto t = hc.getX();
+            auto b = (mvminus)*gutter.getWidth() + gutter.getX();
+            if (t > b)
+                std::swap(t, b);
+            auto val = gutter.withLeft(t).withRight(b);
+            g.setColour(modvaloppcol);
+            g.fillRoundedRectangle(val, gutterheight * 0.25);
+        }
+    }
+
+    if (that->isHovered)
+        g.setColour(that->getColour(T::Styles::handle_hover));
+    else
+        g.setColour(that->getColour(T::Styles::handle));
+    g.fillEllipse(hr);
+    g.setColour(that->getColour(T::Styles::handle_outline));
+    g.drawEllipse(hr, 1);
+    if (that->isEditingMod)
+    {
+        if (that->isHovered)
+            g.setColour(that->getColour(T::Styles::modulation_handle_hover));
+        else
+            g.setColour(that->getColour(T::Styles::modulation_handle));
+        g.fillEllipse(mpr);
+        g.setColour(that->getColour(T::Styles::handle_outline));
+        g.drawEllipse(mpr, 1);
+    }
+}
+
+template <typename T> void vSliderPainter(juce::Graphics &g, T *that)
+{
+    if (!that->continuous())
+    {
+        g.fillAll(juce::Colours::red);
+        return;
+    }
+
+    if (that->continuous()->isHidden())
+        return;
+
+    auto hanRadius = that->style()->getSliderHandleRadius();
+
+    // Gutter
+    g.setColour(that->getColour(T::Styles::gutter));
+    if (that->isHovered)
+        g.setColour(that->getColour(T::Styles::gutter_hover));
+    auto gutter = vSliderGutter(that);
+    g.fillRect(gutter.reduced(1));
+
+    if (!that->isEnabled())
+        return;
+
+    if (that->modulationDisplay == ContinuousParamEditor::FROM_ACTIVE)
+    {
+        g.setColour(that->getColour(T::Styles::modulated_by_selected));
+        g.fillRect(gutter.reduced(2));
+    }
+    else if (that->modulationDisplay == ContinuousParamEditor::FROM_OTHER)
+    {
+        g.setColour(that->getColour(T::Styles::modulated_by_other));
+        g.fillRect(gutter.reduced(2));
+    }
+
+    auto v = that->continuous()->getValue01();
+    auto h = (1.0 - v) * gutter.getHeight();
+    auto hc = gutter.withTrimmedTop(h).withHeight(1).expanded(0, 4).getCentre();
+
+    auto valcol = that->getColour(T::Styles::value);
+    if (that->isHovered)
+        valcol = that->getColour(T::Styles::value_hover);
+
+    if (that->continuous()->isBipolar())
+    {
+        auto t = hc.getY();
+        auto b = gutter.getHeight() / 2 + gutter.getY();
+        if (t > b)
+            std::swap(t, b);
+        auto val = gutter.withTop(t).withBottom(b);
+        g.setColour(valcol);
+        g.fillRect(val);
+    }
+    else
+    {
+        auto val = gutter.withTrimmedTop(h);
+        g.setColour(valcol);
+        g.fillRect(val);
+    }
+
+    auto hr = juce::Rectangle<float>(2 * hanRadius, 2 * hanRadius).withCentre(hc);
+
+    juce::Point<float> mpc;
+    juce::Rectangle<float> mpr;
+
+    if (that->continuousModulatable() && that->isEditingMod)
+    {
+        auto mvplus =
+            std::clamp(v + that->continuousModulatable()->getModulationValuePM1(), 0.f, 1.f);
+        auto mvminus =
+            std::clamp(v - that->continuousModulatable()->getModulationValuePM1(), 0.f, 1.f);
+        auto hm = (1.0 - mvplus) * gutter.getHeight();
+        mpc = gutter.withTrimmedTop(hm).withHeight(1).expanded(0, 4).getCentre();
+        mpr = juce::Rectangle<float>(2 * hanRadius, 2 * hanRadius).withCentre(mpc);
+
+        auto modvalcol = that->getColour(T::Styles::modulation_value);
+        if (that->isHovered)
+            modvalcol = that->getColour(T::Styles::modulation_value_hover);
+
+        auto modvaloppcol = that->getColour(T::Styles::modulation_opposite_value);
+        if (that->isHovered)
+            modvaloppcol = that->getColour(T::Styles::modulation_opposite_value_hover);
+
+        // draw rules
+        {
+            auto t = hc.getY();
+            auto b = (1 - mvplus) * gutter.getHeight() + gutter.getY();
+            if (t > b)
+                std::swap(t, b);
+            auto val = gutter.withTop(t).withBottom(b).reduced(1, 0);
+            g.setColour(modvalcol);
+            g.fillRect(val);
+        }
+
+        if (that->continuousModulatable()->isModulationBipolar())
+        {
+            auto t = hc.getY();
+            auto b = (1 - mvminus) * gutter.getHeight() + gutter.getY();
+            if (t > b)
+                std::swap(t, b);
+            auto val = gutter.withTop(t).withBottom(b).reduced(1, 0);
+            g.setColour(modvaloppcol);
+            g.fillRect(val);
+        }
+    }
+
+    if (that->isHovered)
+        g.setColour(that->getColour(T::Styles::handle_hover));
+    else
+        g.setColour(that->getColour(T::Styles::handle));
+    g.fillEllipse(hr);
+    g.setColour(that->getColour(T::Styles::handle_outline));
+    g.drawEllipse(hr, 0.5);
+    if (that->isEditingMod)
+    {
+        if (that->isHovered)
+            g.setColour(that->getColour(T::Styles::modulation_handle_hover));
+        else
+            g.setColour(that->getColour(T::Styles::modulation_handle));
+        g.fillEllipse(mpr);
+        g.setColour(that->getColour(T::Styles::handle_outline));
+        g.drawEllipse(mpr, 1);
+    }
+}
+} // namespace sst::jucegui::components
+#endif // INCLUDE_SST_JUCEGUI_COMPONENTS_SLIDERPAINTER_HXX
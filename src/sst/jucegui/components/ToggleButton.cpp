@@ -138,7 +138,7 @@ void ToggleButton::paint(juce::Graphics &g)
         {
             paintType = GlyphPainter::SMALL_POWER_LIGHT_OFF;
         }
-        GlyphPainter::paintGlyph(g, getLocalBounds(), paintType, col);
+        GlyphPainter::paintGlyph(g, getLocalBounds(), paintType, col, this);
         return;
     }
 
@@ -154,7 +154,7 @@ void ToggleButton::paint(juce::Graphics &g)
             col = getColour(Styles::value);
         }
 
-        GlyphPainter::paintGlyph(g, getLocalBounds(), v ? type : offType, col);
+        GlyphPainter::paintGlyph(g, getLocalBounds(), v ? type : offType, col, this);
         return;
     }
 
@@ -41,8 +41,8 @@ void ToolTip::paint(juce::Graphics &g)
     g.setColour(bord);
     g.drawRect(getLocalBounds(), 1);
 
-    auto f = style()->getFont(Styles::styleClass, Styles::labelfont);
-    auto rowHeight = f.getHeight() + rowPad;
+    auto fh = getFontHandle(Styles::labelfont);
+    auto rowHeight = fh->height + rowPad;
 
     g.setColour(lbord);
     g.drawLine(3, rowHeight + margin + rowPad / 2, getWidth() - 3, rowHeight + margin + rowPad / 2,
@@ -50,12 +50,12 @@ void ToolTip::paint(juce::Graphics &g)
 
     g.setColour(txtColour);
     auto bx = juce::Rectangle<int>(margin, margin, getWidth() - 2 * margin, rowHeight);
-    g.setFont(f);
+    g.setFont(fh->font);
     g.drawText(tooltipTitle, bx, titleAlignment);
 
-    auto df = style()->getFont(Styles::styleClass, Styles::datafont);
-    rowHeight = df.getHeight() + rowPad;
-    g.setFont(df);
+    auto dfh = getFontHandle(Styles::datafont);
+    rowHeight = dfh->height + rowPad;
+    g.setFont(dfh->font);
 
     bx = bx.translated(0, rowHeight + rowTitlePad);
     g.setColour(txtColour);
@@ -69,10 +69,11 @@ void ToolTip::paint(juce::Graphics &g)
         auto txtbx = bx;
         if (row.rowLeadingGlyph.has_value())
         {
-            GlyphPainter::paintGlyph(g, bx.withWidth(glyphSize), *(row.rowLeadingGlyph), txtColour);
+            GlyphPainter::paintGlyph(g, bx.withWidth(glyphSize), *(row.rowLeadingGlyph), txtColour,
+                                     this);
             txtbx = bx.withTrimmedLeft(glyphSize + 2);
         }
-        g.setFont(row.leftIsMonospace ? df : f);
+        g.setFont(row.leftIsMonospace ? dfh->font : fh->font);
         g.drawText(row.leftAlignText, txtbx, juce::Justification::centredLeft);
 
         // if (row.drawLRArrow && !row.drawRLArrow)
@@ -82,14 +83,14 @@ void ToolTip::paint(juce::Graphics &g)
         //     GlyphPainter::paintGlyph(g, txtbx.withTrimmedLeft(txtbx.getWidth() / 3),
         //                              GlyphPainter::GlyphType::ARROW_L_TO_R, txtColour); // should
         //                              be R_TO_L glyph
-        g.setFont(row.centerIsMonospace ? df : f);
+        g.setFont(row.centerIsMonospace ? dfh->font : fh->font);
         g.drawText(row.centerAlignText, txtbx, juce::Justification::centred);
         // if (row.drawLRArrow && row.drawRLArrow)
         //{
         //     GlyphPainter::paintGlyph(g, txtbx.withTrimmedLeft(2 * txtbx.getWidth() / 3),
         //                              GlyphPainter::GlyphType::ARROW_L_TO_R, txtColour);
         // }
-        g.setFont(row.rightIsMonospace ? df : f);
+        g.setFont(row.rightIsMonospace ? dfh->font : fh->font);
         g.drawText(row.rightAlignText, txtbx, juce::Justification::centredRight);
         bx = bx.translated(0, rh + rowPad);
     }
@@ -97,11 +98,10 @@ void ToolTip::paint(juce::Graphics &g)
 
 void ToolTip::resetSizeFromData()
 {
-    auto f = style()->getFont(Styles::styleClass, Styles::labelfont);
-    auto rowHeight = f.getHeight() + rowPad;
-    auto maxw = std::max(SST_STRING_WIDTH_FLOAT(f, tooltipTitle), 60.f);
+    auto fh = getFontHandle(Styles::labelfont);
+    auto rowHeight = fh->height + rowPad;
+    auto maxw = std::max(SST_STRING_WIDTH_FLOAT(fh->font, tooltipTitle), 60.f);
 
-    auto df = style()->getFont(Styles::styleClass, Styles::datafont);
     auto drowHeight = 0.f;
     for (auto i = 0; i < tooltipData.size(); ++i)
     {
@@ -117,24 +117,24 @@ void ToolTip::resetSizeFromData()
 
 int ToolTip::getRowHeight(int row)
 {
-    auto f = style()->getFont(Styles::styleClass, Styles::labelfont);
-    auto df = style()->getFont(Styles::styleClass, Styles::datafont);
+    auto fh = getFontHandle(Styles::labelfont)->height;
+    auto dfh = getFontHandle(Styles::datafont)->height;
 
     if (tooltipData[row].centerIsMonospace && tooltipData[row].leftIsMonospace &&
         tooltipData[row].rightIsMonospace)
-        return df.getHeight();
+        return dfh;
 
     if (!tooltipData[row].centerIsMonospace && !tooltipData[row].leftIsMonospace &&
         !tooltipData[row].rightIsMonospace)
-        return f.getHeight();
+        return fh;
 
-    return std::max(f.getHeight(), df.getHeight());
+    return std::max(fh, dfh);
 }
 
 int ToolTip::getRowWidth(int ri)
 {
-    auto f = style()->getFont(Styles::styleClass, Styles::labelfont);
-    auto df = style()->getFont(Styles::styleClass, Styles::datafont);
+    auto f = getFontHandle(Styles::labelfont)->font;
+    auto df = getFontHandle(Styles::datafont)->font;
 
     auto &row = tooltipData[ri];
     // Special case -just the text
@@ -0,0 +1,155 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <sst/jucegui/components/VUMeter.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace sst::jucegui::components
+{
+/*
+ * One clock for every fed meter, running at the fastest of their refresh rates. It owns
+ * the set of fed meters and, like the other shared caches, is DeletedAtShutdown so the
+ * timer goes while the message manager is still up.
+ */
+struct VUMeterRefreshClock : juce::Timer, juce::DeletedAtShutdown
+{
+    std::unordered_set<VUMeter *> meters;
+
+    static VUMeterRefreshClock *instance;
+    static VUMeterRefreshClock &get()
+    {
+        if (!instance)
+            instance = new VUMeterRefreshClock();
+        return *instance;
+    }
+    ~VUMeterRefreshClock() override { instance = nullptr; }
+
+    void add(VUMeter *m)
+    {
+        meters.insert(m);
+        restart();
+    }
+    void remove(VUMeter *m)
+    {
+        if (meters.erase(m))
+            restart();
+    }
+
+    void restart()
+    {
+        float hz{0.f};
+        for (auto *m : meters)
+            hz = std::max(hz, m->getRefreshRateHz());
+
+        if (hz <= 0)
+            stopTimer();
+        else
+            startTimerHz(juce::roundToInt(hz));
+    }
+
+    void timerCallback() override
+    {
+        auto now = juce::Time::getMillisecondCounterHiRes();
+        for (auto *m : meters)
+            m->refreshFromFeed(now);
+    }
+};
+VUMeterRefreshClock *VUMeterRefreshClock::instance{nullptr};
+
+VUMeter::~VUMeter()
+{
+    // the clock may already have gone at shutdown, so don't make a new one to leave
+    if (feed && VUMeterRefreshClock::instance)
+        VUMeterRefreshClock::instance->remove(this);
+}
+
+void VUMeter::setLevels(float iL, float iR) { updateLevels(iL, iR); }
+
+void VUMeter::updateLevels(float iL, float iR)
+{
+    L = iL;
+    R = iR;
+    if (levelToPixel(L) != paintedPixelL || levelToPixel(R) != paintedPixelR)
+        repaint();
+}
+
+std::shared_ptr<VUMeter::LevelFeed> VUMeter::getLevelFeed()
+{
+    if (!feed)
+    {
+        feed = std::make_shared<LevelFeed>();
+        subscribeToSetting(style::Settings::maxRepaintHz);
+        lastRefreshMs = juce::Time::getMillisecondCounterHiRes();
+        VUMeterRefreshClock::get().add(this);
+    }
+    return feed;
+}
+
+void VUMeter::setRefreshRateHz(float hz)
+{
+    refreshRateHz = hz;
+    if (feed)
+        VUMeterRefreshClock::get().restart();
+}
+
+float VUMeter::getRefreshRateHz()
+{
+    auto cap = getSetting(style::Settings::maxRepaintHz);
+    if (cap > 0)
+        return std::min(refreshRateHz, cap);
+    return refreshRateHz;
+}
+
+void VUMeter::onSettingChanged(style::Settings::KeyIndex k)
+{
+    if (k == style::Settings::MAX_REPAINT_HZ && feed)
+        VUMeterRefreshClock::get().restart();
+}
+
+static float ballistic(float shown, float in, double &holdUntilMs, double nowMs, double dtMs,
+                       const VUMeter::Ballistics &b)
+{
+    if (in >= shown)
+    {
+        holdUntilMs = nowMs + b.peakHoldMs;
+        return in;
+    }
+    if (nowMs < holdUntilMs)
+        return shown;
+
+    auto fall = std::pow(10.f, -b.releaseDbPerSecond * (float)dtMs * 0.001f / 20.f);
+    return std::max(in, shown * fall);
+}
+
+void VUMeter::refreshFromFeed(double nowMs)
+{
+    // the clock runs at the fastest fed meter's rate, so slower meters skip ticks. The
+    // feed keeps its running maximum across those.
+    auto rate = getRefreshRateHz();
+    auto dtMs = nowMs - lastRefreshMs;
+    if (rate <= 0 || dtMs < 1000.0 / rate - 1.0)
+        return;
+    lastRefreshMs = nowMs;
+
+    auto [inL, inR] = feed->takeLevels();
+    auto nL = ballistic(L, inL, holdUntilMsL, nowMs, dtMs, ballistics);
+    auto nR = ballistic(R, inR, holdUntilMsR, nowMs, dtMs, ballistics);
+    updateLevels(nL, nR);
+}
+} // namespace sst::jucegui::components
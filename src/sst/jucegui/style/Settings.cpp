@@ -0,0 +1,110 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <sst/jucegui/style/Settings.h>
+#include <sst/jucegui/style/StyleAndSettingsConsumer.h>
+#include <algorithm>
+
+namespace sst::jucegui::style
+{
+uint64_t Settings::lastGeneration{1};
+
+static std::array<double, Settings::numKeys> makeKeyDefaults()
+{
+    std::array<double, Settings::numKeys> res{};
+    auto put = [&res](const auto &k) { res[k.index] = (double)k.defaultValue; };
+    put(Settings::hideMouseOnDrag);
+    put(Settings::dragSensitivity);
+    put(Settings::wheelScaling);
+    put(Settings::maxRepaintHz);
+    return res;
+}
+static const auto keyDefaults = makeKeyDefaults();
+
+Settings::~Settings()
+{
+    if (parent)
+    {
+        auto &pc = parent->children;
+        pc.erase(std::remove(pc.begin(), pc.end(), this), pc.end());
+    }
+}
+
+const Settings::ptr_t &Settings::getDefault()
+{
+    static const ptr_t res = std::make_shared<Settings>();
+    return res;
+}
+
+void Settings::setParent(const ptr_t &p)
+{
+    if (parent)
+    {
+        auto &pc = parent->children;
+        pc.erase(std::remove(pc.begin(), pc.end(), this), pc.end());
+    }
+    parent = p;
+    if (parent)
+        parent->children.push_back(this);
+
+    ++lastGeneration;
+    for (int k = 0; k < numKeys; ++k)
+    {
+        if (!values[k].has_value())
+            notifyKeyChanged((KeyIndex)k);
+    }
+}
+
+void Settings::setRaw(KeyIndex k, std::optional<double> v)
+{
+    if (values[k] == v)
+        return;
+    values[k] = v;
+    ++lastGeneration;
+    notifyKeyChanged(k);
+}
+
+void Settings::resolveAll() const
+{
+    for (int k = 0; k < numKeys; ++k)
+    {
+        auto *s = this;
+        while (s && !s->values[k].has_value())
+            s = s->parent.get();
+        resolved[k] = s ? *(s->values[k]) : keyDefaults[k];
+    }
+    resolvedGeneration = lastGeneration;
+}
+
+void Settings::notifyKeyChanged(KeyIndex k)
+{
+    // Copy, since a handler may subscribe or unsubscribe, or destroy another subscriber
+    auto subs = std::vector<SettingsConsumer *>(subscribers[k].begin(), subscribers[k].end());
+    for (auto *sc : subs)
+    {
+        if (subscribers[k].count(sc))
+            sc->onSettingChanged(k);
+    }
+
+    // Children which override the key don't see the change
+    for (auto *c : children)
+    {
+        if (!c->values[k].has_value())
+            c->notifyKeyChanged(k);
+    }
+}
+} // namespace sst::jucegui::style
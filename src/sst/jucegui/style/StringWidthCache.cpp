@@ -0,0 +1,132 @@
+/*
+ * sst-jucegui - an open source library of juce widgets
+ * built by Surge Synth Team.
+ *
+ * Copyright 2023-2024, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-jucegui is released under the MIT license, as described
+ * by "LICENSE.md" in this repository. This means you may use this
+ * in commercial software if you are a JUCE Licensee. If you use JUCE
+ * in the open source / GPL3 context, your combined work must be
+ * released under GPL3.
+ *
+ * All source in sst-jucegui available at
+ * https://github.com/surge-synthesizer/sst-jucegui
+ */
+
+#include <sst/jucegui/style/StringWidthCache.h>
+#include <sst/jucegui/style/StyleSheet.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <cstring>
+
+namespace sst::jucegui::style
+{
+struct StringWidthCacheKey
+{
+    uint64_t font;
+    juce::String text;
+
+    bool operator==(const StringWidthCacheKey &other) const
+    {
+        return font == other.font && text == other.text;
+    }
+};
+
+struct StringWidthCacheKeyHash
+{
+    size_t operator()(const StringWidthCacheKey &k) const
+    {
+        return (size_t)(k.font * 0x9E3779B97F4A7C15ULL ^ (uint64_t)k.text.hashCode64());
+    }
+};
+
+struct StringWidthCacheLRU
+{
+    std::mutex lock;
+    std::list<std::pair<StringWidthCacheKey, float>> entries; // most recently used first
+    std::unordered_map<StringWidthCacheKey, decltype(entries)::iterator, StringWidthCacheKeyHash>
+        index;
+};
+
+static StringWidthCacheLRU &lru()
+{
+    static StringWidthCacheLRU instance;
+    return instance;
+}
+
+// Handle ids and font descriptions share the key space; keep them apart with the top bit
+static constexpr uint64_t fontDescriptionBit{1ULL << 63};
+
+static uint64_t mix(uint64_t h, uint64_t v) { return (h ^ v) * 1099511628211ULL; }
+
+static uint64_t floatBits(float f)
+{
+    uint32_t r;
+    std::memcpy(&r, &f, sizeof(r));
+    return r;
+}
+
+static uint64_t descriptionKey(const juce::Font &f)
+{
+    uint64_t h{14695981039346656037ULL};
+    h = mix(h, (uint64_t)f.getTypefaceName().hashCode64());
+    h = mix(h, (uint64_t)f.getTypefaceStyle().hashCode64());
+    h = mix(h, floatBits(f.getHeight()));
+    h = mix(h, floatBits(f.getExtraKerningFactor()));
+    h = mix(h, floatBits(f.getHorizontalScale()));
+    return h | fontDescriptionBit;
+}
+
+static float lookup(uint64_t fontKey, const juce::Font &f, const juce::String &s)
+{
+    auto &c = lru();
+    std::lock_guard<std::mutex> g(c.lock);
+
+    StringWidthCacheKey k{fontKey, s};
+    auto it = c.index.find(k);
+    if (it != c.index.end())
+    {
+        c.entries.splice(c.entries.begin(), c.entries, it->second);
+        return it->second->second;
+    }
+
+    auto w = SST_STRING_WIDTH_FLOAT_UNCACHED(f, s);
+    c.entries.emplace_front(std::move(k), w);
+    c.index.emplace(c.entries.front().first, c.entries.begin());
+    if (c.entries.size() > StringWidthCache::maxEntries)
+    {
+        c.index.erase(c.entries.back().first);
+        c.entries.pop_back();
+    }
+    return w;
+}
+
+float StringWidthCache::getStringWidth(const juce::Font &f, const juce::String &s)
+{
+    return lookup(descriptionKey(f), f, s);
+}
+
+float StringWidthCache::getStringWidth(const FontHandle &f, const juce::String &s)
+{
+    return lookup(f.id & ~fontDescriptionBit, f.font, s);
+}
+
+void StringWidthCache::clear()
+{
+    auto &c = lru();
+    std::lock_guard<std::mutex> g(c.lock);
+    c.index.clear();
+    c.entries.clear();
+}
+
+size_t StringWidthCache::size()
+{
+    auto &c = lru();
+    std::lock_guard<std::mutex> g(c.lock);
+    return c.entries.size();
+}
+} // namespace sst::jucegui::style
@@ -16,36 +16,148 @@
  */
 
 #include <sst/jucegui/style/StyleAndSettingsConsumer.h>
+#include <unordered_map>
 
 namespace sst::jucegui::style
 {
-void StyleConsumer::setStyle(const StyleSheet::ptr_t &s)
+/*
+ * Components whose consumer holds a sheet, so that finding the nearest styled ancestor
+ * needs no RTTI. Entries are added and removed by adoptStyle, and only ever touched
+ * on the message thread.
+ */
+static std::unordered_map<const juce::Component *, StyleConsumer *> &styledComponents()
+{
+    static std::unordered_map<const juce::Component *, StyleConsumer *> res;
+    return res;
+}
+
+StyleConsumer::~StyleConsumer()
+{
+    adoptStyle(nullptr);
+    if (component)
+        component->removeComponentListener(&hierarchyListener);
+}
+
+juce::Component *StyleConsumer::styledComponent()
 {
+    if (!componentResolved)
+    {
+        componentResolved = true;
+        component = dynamic_cast<juce::Component *>(this);
+        if (component)
+            component->addComponentListener(&hierarchyListener);
+    }
+    return component;
+}
+
+void StyleConsumer::adoptStyle(const StyleSheet::ptr_t &s)
+{
+    if (attachedSheet)
+        attachedSheet->detachConsumer(this);
     stylep = s;
-    onStyleChanged();
+    if (stylep)
+        stylep->attachConsumer(this);
 
-    auto jc = dynamic_cast<juce::Component *>(this);
-    std::function<void(juce::Component *)> rec;
-    rec = [&rec, s](juce::Component *comp) {
-        if (!comp)
-            return;
-        for (auto c : comp->getChildren())
+    if (component)
+    {
+        if (stylep)
+            styledComponents()[component] = this;
+        else
+            styledComponents().erase(component);
+    }
+}
+
+StyleSheet::ptr_t StyleConsumer::styleForComponentOrAncestors(juce::Component *c)
+{
+    auto &reg = styledComponents();
+    for (; c; c = c->getParentComponent())
+    {
+        auto f = reg.find(c);
+        if (f != reg.end())
         {
-            auto sc = dynamic_cast<StyleConsumer *>(c);
-            if (sc)
-            {
-                sc->setStyle(s);
-            }
-            else
-            {
-                rec(c);
-            }
+            // an ancestor's own sheet may be stale after a reparent too
+            f->second->resolveStyle();
+            return f->second->stylep;
         }
-    };
-    if (jc)
+    }
+    return nullptr;
+}
+
+void StyleConsumer::resolveFromAncestors()
+{
+    inheritedStyleStale = false;
+
+    auto *jc = styledComponent();
+    if (!jc)
+        return;
+
+    auto ps = styleForComponentOrAncestors(jc->getParentComponent());
+    /* Please ask BP before you nuke this debug code
+    if (!ps && !stylep)
     {
-        rec(jc);
+        std::cout << "Style Unresolved" << std::endl;
+
+        std::string pfx = "";
+        while (jc)
+        {
+            std::cout << pfx << jc << " " << jc->getTitle() << " "
+                      << jc->getBounds().toString() << " " << typeid(*jc).name() << " "
+                      << styledComponents().count(jc) << "\n";
+            pfx = pfx + "   ";
+            jc = jc->getParentComponent();
+        }
+    }
+     */
+
+    // Moving out of a styled tree keeps the sheet we had rather than losing it
+    if (ps && ps != stylep)
+    {
+        adoptStyle(ps);
+        styleInherited = true;
+        onStyleChanged();
     }
+}
+
+void StyleConsumer::HierarchyListener::componentParentHierarchyChanged(juce::Component &)
+{
+    if (!owner.stylep || owner.styleInherited)
+        owner.inheritedStyleStale = true;
+}
+
+void StyleConsumer::HierarchyListener::componentBeingDeleted(juce::Component &c)
+{
+    styledComponents().erase(&c);
+    c.removeComponentListener(this);
+    owner.component = nullptr;
+}
+
+void StyleConsumer::setStyle(const StyleSheet::ptr_t &s) { applyStyle(s, false); }
+
+void StyleConsumer::applyStyle(const StyleSheet::ptr_t &s, bool inherited)
+{
+    auto jc = styledComponent();
+    adoptStyle(s);
+    styleInherited = inherited;
+    inheritedStyleStale = false;
+    onStyleChanged();
+
+    if (!jc || inherited)
+        return;
+
+    // A style change can rebuild children; anyone the first pass missed gets a second
+    auto &roster = ConsumerRoster::forRoot(jc);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const auto &es = roster.entries();
+        for (size_t i = 1; i < es.size(); ++i)
+        {
+            if (es[i].style && es[i].component && (pass == 0 || es[i].style->stylep != s))
+                es[i].style->applyStyle(s, true);
+        }
+        if (!roster.isDirty())
+            break;
+    }
+
     if (jc->isShowing())
         jc->repaint();
 }
@@ -76,33 +188,128 @@ void StyleConsumer::notifyOnStyleChanged()
         jc->repaint();
 }
 
-void SettingsConsumer::setSettings(const Settings::ptr_t &s)
+SettingsConsumer::~SettingsConsumer()
 {
+    // Leave whatever we read from, which may be the shared default, holding nothing of ours
+    auto &from = settings();
+    for (int k = 0; k < Settings::numKeys; ++k)
+    {
+        if (subscribedKeys & (1u << k))
+            from->unsubscribe((Settings::KeyIndex)k, this);
+    }
+}
+
+void SettingsConsumer::adoptSettings(const Settings::ptr_t &s)
+{
+    auto &from = settings();
+    auto &to = s ? s : Settings::getDefault();
+    if (subscribedKeys && from != to)
+    {
+        for (int k = 0; k < Settings::numKeys; ++k)
+        {
+            if (subscribedKeys & (1u << k))
+            {
+                from->unsubscribe((Settings::KeyIndex)k, this);
+                to->subscribe((Settings::KeyIndex)k, this);
+            }
+        }
+    }
     settingsp = s;
+}
+
+void SettingsConsumer::setSettings(const Settings::ptr_t &s)
+{
+    adoptSettings(s);
     onSettingsChanged();
 
     auto jc = dynamic_cast<juce::Component *>(this);
-    std::function<void(juce::Component *)> rec;
-    rec = [&rec, s](juce::Component *comp) {
-        if (!comp)
-            return;
-        for (auto c : comp->getChildren())
+    if (!jc)
+        return;
+
+    auto &roster = ConsumerRoster::forRoot(jc);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const auto &es = roster.entries();
+        for (size_t i = 1; i < es.size(); ++i)
         {
-            auto sc = dynamic_cast<SettingsConsumer *>(c);
-            if (sc)
+            auto *sc = es[i].settings;
+            if (sc && es[i].component && (pass == 0 || sc->settingsp != s))
             {
-                sc->setSettings(s);
-            }
-            else
-            {
-                rec(c);
+                sc->adoptSettings(s);
+                sc->onSettingsChanged();
             }
         }
-    };
-    if (jc)
-    {
-        rec(jc);
+        if (!roster.isDirty())
+            break;
     }
     jc->repaint();
 }
+
+static std::unordered_map<const juce::Component *, std::unique_ptr<ConsumerRoster>> &rosters()
+{
+    static std::unordered_map<const juce::Component *, std::unique_ptr<ConsumerRoster>> res;
+    return res;
+}
+
+ConsumerRoster &ConsumerRoster::forRoot(juce::Component *root)
+{
+    auto &r = rosters()[root];
+    if (!r)
+        r.reset(new ConsumerRoster(root));
+    return *r;
+}
+
+ConsumerRoster::~ConsumerRoster() { unwatchAll(); }
+
+const std::vector<ConsumerRoster::Entry> &ConsumerRoster::entries()
+{
+    if (dirty)
+        rebuild();
+    return list;
+}
+
+void ConsumerRoster::rebuild()
+{
+    unwatchAll();
+    list.clear();
+
+    std::vector<juce::Component *> stack{root};
+    while (!stack.empty())
+    {
+        auto *c = stack.back();
+        stack.pop_back();
+
+        c->addComponentListener(this);
+        watched.insert(c);
+        list.push_back({c, dynamic_cast<StyleConsumer *>(c), dynamic_cast<SettingsConsumer *>(c)});
+
+        // push in reverse so children come out in order, keeping the walk pre-order
+        const auto &kids = c->getChildren();
+        for (auto k = kids.rbegin(); k != kids.rend(); ++k)
+            stack.push_back(*k);
+    }
+    dirty = false;
+}
+
+void ConsumerRoster::unwatchAll()
+{
+    for (auto *c : watched)
+        c->removeComponentListener(this);
+    watched.clear();
+}
+
+void ConsumerRoster::componentBeingDeleted(juce::Component &c)
+{
+    c.removeComponentListener(this);
+    watched.erase(&c);
+    dirty = true;
+
+    if (&c == root)
+    {
+        // this destroys us, so touch nothing afterwards
+        rosters().erase(root);
+        return;
+    }
+}
+
 } // namespace sst::jucegui::style
\ No newline at end of file
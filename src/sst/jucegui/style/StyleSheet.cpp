@@ -18,7 +18,13 @@
 #include "sst/jucegui/components/GlyphButton.h"
 #include "sst/jucegui/components/GlyphPainter.h"
 #include <sst/jucegui/style/StyleSheet.h>
+#include <sst/jucegui/style/StyleAndSettingsConsumer.h>
 #include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <functional>
 
 #include <sst/jucegui/components/DraggableTextEditableValue.h>
 #include <sst/jucegui/components/Knob.h>
@@ -65,9 +71,62 @@ std::unordered_map<const StyleSheet::Property *, const StyleSheet::Class *>
 std::unordered_map<const StyleSheet::Class *, std::vector<const StyleSheet::Class *>>
     StyleSheet::inheritanceStructureDerivedFrom, StyleSheet::inheritanceStructureParentTo;
 
+std::vector<std::string> StyleSheet::classNamesById, StyleSheet::propertyNamesById;
+std::vector<std::vector<int>> StyleSheet::inheritFromToById, StyleSheet::derivedClassesById;
+uint64_t StyleSheet::inheritanceEpoch{1};
+uint64_t StyleSheet::lastGeneration{0};
+std::atomic<uint64_t> FontHandle::lastId{0};
+std::unordered_map<uint64_t, int> StyleSheet::classIdsByHash, StyleSheet::propertyIdsByHash;
+
+int StyleSheet::classIdFor(const StyleSheet::Class &c)
+{
+    if (c.id >= 0)
+        return c.id;
+
+    c.id = classIdForName(c.hash, c.name);
+    return c.id;
+}
+
+int StyleSheet::classIdForName(uint64_t hash, std::string_view name)
+{
+    auto [it, inserted] = classIdsByHash.try_emplace(hash, (int)classNamesById.size());
+    // a hash collision between two distinct names would merge their styles
+    jassert(inserted || classNamesById[(size_t)it->second] == name);
+    if (inserted)
+    {
+        classNamesById.emplace_back(name);
+        inheritFromToById.emplace_back();
+        derivedClassesById.emplace_back();
+    }
+    return it->second;
+}
+
+int StyleSheet::propertyIdFor(const StyleSheet::Property &p)
+{
+    if (p.id >= 0)
+        return p.id;
+
+    p.id = propertyIdForName(p.hash, p.name);
+    return p.id;
+}
+
+int StyleSheet::propertyIdForName(uint64_t hash, std::string_view name)
+{
+    auto [it, inserted] = propertyIdsByHash.try_emplace(hash, (int)propertyNamesById.size());
+    jassert(inserted || propertyNamesById[(size_t)it->second] == name);
+    if (inserted)
+        propertyNamesById.emplace_back(name);
+    return it->second;
+}
+
 void StyleSheet::extendInheritanceMap(const StyleSheet::Class &from, const StyleSheet::Class &to)
 {
     inheritFromTo[from.cname].push_back(to.cname);
+    auto fromId = classIdFor(from);
+    auto toId = classIdFor(to);
+    inheritFromToById[(size_t)fromId].push_back(toId);
+    derivedClassesById[(size_t)toId].push_back(fromId);
+    inheritanceEpoch++;
     inheritanceStructureDerivedFrom[&from].push_back(&to);
     inheritanceStructureParentTo[&to].push_back(&from);
 }
@@ -85,69 +144,300 @@ struct BuiltInDeleteStyleResetter : juce::DeletedAtShutdown
     }
 };
 
+/*
+ * Values for a sheet live in a flat [classId][propertyId] grid of slot indices into a
+ * dense value vector. A lookup is an array index and a bounds check, with no hashing or
+ * allocation. The grid grows (and re-strides) when new ids are registered after the sheet
+ * was populated, which in practice only happens during startup.
+ *
+ * Alongside the direct slots we keep a resolved grid, with the same meaning but with
+ * inheritance already applied. Resolved cells are filled lazily on first query. Since they
+ * point at slots rather than copying values, overwriting an existing value (or restyling
+ * every font) needs no invalidation at all; only creating a new slot for (class, property)
+ * invalidates that property's cells in the class and the classes which derive from it.
+ */
+template <typename T> struct FlatPropertyTable
+{
+    static constexpr int32_t noSlot{-1};
+    static constexpr int32_t unresolved{-2};
+
+    std::vector<int32_t> slots;
+    std::vector<T> values;
+    size_t rows{0}, stride{0};
+
+    mutable std::vector<int32_t> resolved;
+    mutable size_t resolvedRows{0}, resolvedStride{0};
+    mutable uint64_t resolvedInheritanceEpoch{0};
+
+    int32_t slotFor(int c, int p) const
+    {
+        if (c < 0 || p < 0 || (size_t)c >= rows || (size_t)p >= stride)
+            return noSlot;
+        return slots[(size_t)c * stride + (size_t)p];
+    }
+
+    const T *find(int c, int p) const
+    {
+        auto s = slotFor(c, p);
+        return s == noSlot ? nullptr : &values[(size_t)s];
+    }
+
+    // The lookup, with inheritance applied, used by the getters
+    const T *findResolved(int c, int p) const
+    {
+        if (c < 0 || p < 0)
+            return nullptr;
+
+        if (resolvedInheritanceEpoch != StyleSheet::inheritanceEpoch ||
+            (size_t)c >= resolvedRows || (size_t)p >= resolvedStride)
+            resetResolution();
+
+        auto &r = resolved[(size_t)c * resolvedStride + (size_t)p];
+        if (r == unresolved)
+            r = resolveSlot(c, p);
+        return r == noSlot ? nullptr : &values[(size_t)r];
+    }
+
+    // The depth first walk through the base classes which the resolved grid caches
+    int32_t resolveSlot(int c, int p) const
+    {
+        auto s = slotFor(c, p);
+        if (s != noSlot)
+            return s;
+
+        if ((size_t)c < StyleSheet::inheritFromToById.size())
+        {
+            for (auto k : StyleSheet::inheritFromToById[(size_t)c])
+            {
+                auto q = resolveSlot(k, p);
+                if (q != noSlot)
+                    return q;
+            }
+        }
+        return noSlot;
+    }
+
+#if SST_JUCEGUI_STYLE_PROFILING
+    // How many base classes up resolveSlot finds (c, p), or -1 if it doesn't
+    int resolveDepth(int c, int p) const
+    {
+        if (slotFor(c, p) != noSlot)
+            return 0;
+
+        if ((size_t)c < StyleSheet::inheritFromToById.size())
+        {
+            for (auto k : StyleSheet::inheritFromToById[(size_t)c])
+            {
+                auto d = resolveDepth(k, p);
+                if (d >= 0)
+                    return d + 1;
+            }
+        }
+        return -1;
+    }
+#endif
+
+    void resetResolution() const
+    {
+        resolvedRows = StyleSheet::registeredClassCount();
+        resolvedStride = StyleSheet::registeredPropertyCount();
+        resolved.assign(resolvedRows * resolvedStride, unresolved);
+        resolvedInheritanceEpoch = StyleSheet::inheritanceEpoch;
+    }
+
+    void invalidateResolution(int c, int p)
+    {
+        if ((size_t)c >= resolvedRows || (size_t)p >= resolvedStride)
+            return;
+
+        resolved[(size_t)c * resolvedStride + (size_t)p] = unresolved;
+        if ((size_t)c < StyleSheet::derivedClassesById.size())
+        {
+            for (auto d : StyleSheet::derivedClassesById[(size_t)c])
+                invalidateResolution(d, p);
+        }
+    }
+
+    void set(int c, int p, const T &v)
+    {
+        reserveFor(c, p);
+        auto &s = slots[(size_t)c * stride + (size_t)p];
+        if (s == noSlot)
+        {
+            s = (int32_t)values.size();
+            values.push_back(v);
+            invalidateResolution(c, p);
+        }
+        else
+        {
+            values[(size_t)s] = v;
+        }
+    }
+
+    void reserveFor(int c, int p)
+    {
+        auto nr = std::max({rows, (size_t)c + 1, StyleSheet::registeredClassCount()});
+        auto ns = std::max({stride, (size_t)p + 1, StyleSheet::registeredPropertyCount()});
+        if (nr == rows && ns == stride)
+            return;
+
+        std::vector<int32_t> newSlots(nr * ns, noSlot);
+        for (size_t r = 0; r < rows; ++r)
+            for (size_t q = 0; q < stride; ++q)
+                newSlots[r * ns + q] = slots[r * stride + q];
+        slots = std::move(newSlots);
+        rows = nr;
+        stride = ns;
+    }
+};
+
+#if SST_JUCEGUI_STYLE_PROFILING
+struct LookupProfile
+{
+    static constexpr size_t maxDepth{8}; // the last bucket collects anything deeper
+
+    struct Entry
+    {
+        uint64_t count{0}, nanos{0}, misses{0};
+        std::array<uint64_t, maxDepth> depths{};
+    };
+
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+
+    static LookupProfile &get()
+    {
+        static LookupProfile res;
+        return res;
+    }
+
+    void record(int c, int p, int depth, uint64_t nanos)
+    {
+        std::lock_guard<std::mutex> g(mutex);
+        auto &e = entries[((uint64_t)(uint32_t)c << 32) | (uint32_t)p];
+        e.count++;
+        e.nanos += nanos;
+        if (depth < 0)
+            e.misses++;
+        else
+            e.depths[std::min((size_t)depth, maxDepth - 1)]++;
+    }
+};
+
+// Times one lookup in a FlatPropertyTable and records where it resolved
+template <typename T> struct ProfiledLookup
+{
+    const FlatPropertyTable<T> &table;
+    int c, p;
+    std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+
+    ProfiledLookup(const FlatPropertyTable<T> &t, int ci, int pi) : table(t), c(ci), p(pi) {}
+    ~ProfiledLookup()
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+        LookupProfile::get().record(c, p, table.resolveDepth(c, p), (uint64_t)ns);
+    }
+};
+#define SST_STYLE_PROFILE_LOOKUP(table, c, p)                                                      \
+    ProfiledLookup<std::decay_t<decltype(table.values[0])>> sstStyleLookupProfile(                 \
+        table, classIdFor(c), propertyIdFor(p))
+#else
+#define SST_STYLE_PROFILE_LOOKUP(table, c, p)
+#endif
+
 struct StyleSheetBuiltInImpl : public StyleSheet
 {
     StyleSheetBuiltInImpl() {}
     ~StyleSheetBuiltInImpl() {}
 
-    std::unordered_map<std::string, std::unordered_map<std::string, juce::Colour>> colours;
-    std::unordered_map<std::string, std::unordered_map<std::string, juce::Font>> fonts;
-    // Baseline heights captured at setFont time; setFontHeightDelta uses these
-    // so repeated calls don't compound when the sheet is a shared singleton.
-    std::unordered_map<std::string, std::unordered_map<std::string, float>> baselineHeights;
-    void setColour(const StyleSheet::Class &c, const StyleSheet::Property &p,
-                   const juce::Colour &col) override
+    struct FontEntry
+    {
+        juce::Font font;
+        // Baseline height captured at setFont time; setFontHeightDelta uses this
+        // so repeated calls don't compound when the sheet is a shared singleton.
+        float baselineHeight;
+        // Set by replaceFontsWithTypeface, whose typeface may not be findable by name
+        bool replacedTypeface{false};
+        // Built on first request and dropped whenever font changes
+        mutable FontHandle::ptr_t handle{};
+    };
+    FlatPropertyTable<juce::Colour> colours;
+    FlatPropertyTable<FontEntry> fonts;
+
+    void doSetColour(const StyleSheet::Class &c, const StyleSheet::Property &p,
+                     const juce::Colour &col) override
     {
         jassert(isValidPair(c, p));
-        colours[c.cname][p.pname] = col;
+        colours.set(classIdFor(c), propertyIdFor(p), col);
     }
-    void setFont(const StyleSheet::Class &c, const StyleSheet::Property &p,
-                 const juce::Font &f) override
+    void doSetFont(const StyleSheet::Class &c, const StyleSheet::Property &p,
+                   const juce::Font &f) override
     {
         jassert(isValidPair(c, p));
+        fonts.set(classIdFor(c), propertyIdFor(p), {f, f.getHeight(), false, nullptr});
+    }
 
-        fonts[c.cname].insert_or_assign(p.pname, f);
-        baselineHeights[c.cname].insert_or_assign(p.pname, f.getHeight());
+    void doReplaceFontsWithTypeface(const juce::Typeface::Ptr &p) override
+    {
+        for (auto &fe : fonts.values)
+        {
+            auto nf = SST_JUCE_FONT_CTOR(p);
+            nf.setHeight(fe.font.getHeight());
+            fe.font = nf;
+            fe.replacedTypeface = true;
+            fe.handle.reset();
+        }
     }
+    void doReplaceFontsWithFamily(const juce::String &familyName) override { assert(false); }
 
-    void replaceFontsWithTypeface(const juce::Typeface::Ptr &p) override
+    void doSetFontHeightDelta(float delta) override
     {
-        for (auto &[cn, propFonts] : fonts)
+        for (auto &fe : fonts.values)
         {
-            for (auto &[pn, f] : propFonts)
-            {
-                auto nf = SST_JUCE_FONT_CTOR(p);
-                nf.setHeight(f.getHeight());
-                f = nf;
-            }
+            fe.font.setHeight(fe.baselineHeight + delta);
+            fe.handle.reset();
+        }
+    }
+    void doSetFontExtraKerningFactor(float kf) override
+    {
+        for (auto &fe : fonts.values)
+        {
+            fe.font.setExtraKerningFactor(kf);
+            fe.handle.reset();
         }
     }
-    void replaceFontsWithFamily(const juce::String familyName) override { assert(false); }
 
-    void setFontHeightDelta(float delta) override
+    bool definesById(int classId, int propertyId, Property::Type type) const override
     {
-        for (auto &[cn, propFonts] : fonts)
-            for (auto &[pn, f] : propFonts)
-                f.setHeight(baselineHeights[cn][pn] + delta);
+        if (type == Property::COLOUR)
+            return colours.find(classId, propertyId) != nullptr;
+        return fonts.find(classId, propertyId) != nullptr;
     }
-    void setFontExtraKerningFactor(float kf) override
+
+    void forEachDirectDefinition(
+        const std::function<void(int, int, const juce::Colour *, const DirectFont *)> &f)
+        const override
     {
-        for (auto &[cn, propFonts] : fonts)
-            for (auto &[pn, f] : propFonts)
-                f.setExtraKerningFactor(kf);
+        for (size_t c = 0; c < colours.rows; ++c)
+            for (size_t p = 0; p < colours.stride; ++p)
+                if (auto v = colours.find((int)c, (int)p))
+                    f((int)c, (int)p, v, nullptr);
+
+        for (size_t c = 0; c < fonts.rows; ++c)
+            for (size_t p = 0; p < fonts.stride; ++p)
+                if (auto v = fonts.find((int)c, (int)p))
+                {
+                    auto df = DirectFont{&v->font, v->baselineHeight, v->replacedTypeface};
+                    f((int)c, (int)p, nullptr, &df);
+                }
     }
 
     bool hasColour(const Class &c, const Property &p) const override
     {
         assert(p.type == Property::COLOUR);
-        auto byC = colours.find(c.cname);
-        if (byC != colours.end())
-        {
-            auto byP = byC->second.find(p.pname);
-            if (byP != byC->second.end())
-                return true;
-        }
-        return false;
+        return colours.find(classIdFor(c), propertyIdFor(p)) != nullptr;
     }
 
     juce::Colour getColour(const Class &c, const Property &p) const override
@@ -156,35 +446,19 @@ struct StyleSheetBuiltInImpl : public StyleSheet
         if (r.has_value())
             return *r;
 
-        std::cout << __FILE__ << ":" << __LINE__ << " COLOUR Missing : " << c.cname
-                  << "::" << p.pname << std::endl;
+        noteMissing(c, p);
         return juce::Colours::red;
     }
 
     std::optional<juce::Colour> getColourOptional(const Class &c, const Property &p) const override
     {
         assert(p.type == Property::COLOUR);
-        auto byC = colours.find(c.cname);
-        if (byC != colours.end())
+        SST_STYLE_PROFILE_LOOKUP(colours, c, p);
+        auto r = colours.findResolved(classIdFor(c), propertyIdFor(p));
+        if (r)
         {
-            auto byP = byC->second.find(p.pname);
-            if (byP != byC->second.end())
-            {
-                jassert(isValidPair(c, p));
-
-                return byP->second;
-            }
-        }
-
-        auto parC = inheritFromTo.find(c.cname);
-        if (parC != inheritFromTo.end())
-        {
-            for (const auto &k : parC->second)
-            {
-                auto sub = getColourOptional({k.c_str()}, p);
-                if (sub.has_value())
-                    return sub;
-            }
+            jassert(isValidPair(c, p));
+            return *r;
         }
         return std::nullopt;
     }
@@ -192,14 +466,7 @@ struct StyleSheetBuiltInImpl : public StyleSheet
     bool hasFont(const Class &c, const Property &p) const override
     {
         assert(p.type == Property::FONT);
-        auto byC = fonts.find(c.cname);
-        if (byC != fonts.end())
-        {
-            auto byP = byC->second.find(p.pname);
-            if (byP != byC->second.end())
-                return true;
-        }
-        return false;
+        return fonts.find(classIdFor(c), propertyIdFor(p)) != nullptr;
     }
 
     juce::Font getFont(const Class &c, const Property &p) const override
@@ -208,37 +475,34 @@ struct StyleSheetBuiltInImpl : public StyleSheet
         if (r.has_value())
             return *r;
 
-        std::cout << __FILE__ << ":" << __LINE__ << " FONT Missing : " << c.cname << "::" << p.pname
-                  << std::endl;
+        noteMissing(c, p);
         return SST_JUCE_FONT_CTOR(36, juce::Font::italic);
     }
     std::optional<juce::Font> getFontOptional(const Class &c, const Property &p) const override
     {
         assert(p.type == Property::FONT);
-        auto byC = fonts.find(c.cname);
-        if (byC != fonts.end())
-        {
-            auto byP = byC->second.find(p.pname);
-            if (byP != byC->second.end())
-            {
-                jassert(isValidPair(c, p));
-                return byP->second;
-            }
-        }
-
-        auto parC = inheritFromTo.find(c.cname);
-        if (parC != inheritFromTo.end())
+        SST_STYLE_PROFILE_LOOKUP(fonts, c, p);
+        auto r = fonts.findResolved(classIdFor(c), propertyIdFor(p));
+        if (r)
         {
-            for (const auto &k : parC->second)
-            {
-                auto q = getFontOptional({k.c_str()}, p);
-                if (q.has_value())
-                    return *q;
-            }
+            jassert(isValidPair(c, p));
+            return r->font;
         }
-
         return std::nullopt;
     }
+
+    FontHandle::ptr_t getFontHandle(const Class &c, const Property &p) const override
+    {
+        assert(p.type == Property::FONT);
+        SST_STYLE_PROFILE_LOOKUP(fonts, c, p);
+        auto r = fonts.findResolved(classIdFor(c), propertyIdFor(p));
+        if (!r)
+            return StyleSheet::getFontHandle(c, p);
+
+        if (!r->handle)
+            r->handle = std::make_shared<const FontHandle>(r->font);
+        return r->handle;
+    }
 };
 
 struct DarkSheet : public StyleSheetBuiltInImpl
@@ -600,9 +864,400 @@ StyleSheet::ptr_t StyleSheet::getBuiltInStyleSheet(const BuiltInTypes &t)
     }
 }
 
+/*
+ * The binary theme layout. All fields are native (little endian on every platform we
+ * ship) and the file is
+ *
+ *     ThemeHeader
+ *     uint32_t nameOffsets[nameCount + 1]   into the name bytes which follow
+ *     char names[nameBytes]                 not nul terminated
+ *     ThemeColour colours[colourCount]
+ *     ThemeFont fonts[fontCount]
+ *
+ * with entries naming classes, properties and typefaces by index into the name table.
+ * Records are memcpy'd out rather than cast, so the buffer needs no alignment.
+ *
+ * Version 2 added the sheet's height delta and kerning factor to the header, and each
+ * font's baseline height and flags.
+ */
+static constexpr char themeMagic[4]{'S', 'S', 'T', 'T'};
+static constexpr uint32_t themeVersion{2};
+
+struct ThemeHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t nameCount, nameBytes, colourCount, fontCount;
+    int32_t sliderGutterWidth, sliderHandleRadius;
+    int32_t knobRingStrokeWide, knobRingStrokeNarrow, knobRingStrokeThreshold;
+    float fontHeightDelta, fontExtraKerningFactor;
+};
+
+struct ThemeColour
+{
+    uint16_t classIdx, propertyIdx;
+    uint32_t argb;
+};
+
+struct ThemeFont
+{
+    // The typeface came from replaceFontsWithTypeface; its name may not find it again
+    static constexpr uint32_t replacedTypeface{1};
+
+    uint16_t classIdx, propertyIdx, typefaceIdx, styleFlags;
+    float height, baselineHeight, kerning;
+    uint32_t flags;
+};
+
+// Accumulates a theme and lays it out; shared by the sheet and JSON writers
+struct ThemeWriter
+{
+    ThemeHeader header{};
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint16_t> nameIndex;
+    std::vector<ThemeColour> colours;
+    std::vector<ThemeFont> fonts;
+
+    uint16_t nameIdx(const std::string &n)
+    {
+        auto [it, inserted] = nameIndex.try_emplace(n, (uint16_t)names.size());
+        jassert(names.size() < 0xFFFF);
+        if (inserted)
+            names.push_back(n);
+        return it->second;
+    }
+
+    void addColour(const std::string &c, const std::string &p, const juce::Colour &col)
+    {
+        colours.push_back({nameIdx(c), nameIdx(p), col.getARGB()});
+    }
+
+    void addFont(const std::string &c, const std::string &p, const std::string &typeface,
+                 int styleFlags, float height, float baselineHeight, float kerning, uint32_t flags)
+    {
+        fonts.push_back({nameIdx(c), nameIdx(p), nameIdx(typeface), (uint16_t)styleFlags, height,
+                         baselineHeight, kerning, flags});
+    }
+
+    std::vector<uint8_t> bytes()
+    {
+        std::vector<uint32_t> offsets{0};
+        for (auto &n : names)
+            offsets.push_back(offsets.back() + (uint32_t)n.size());
+
+        memcpy(header.magic, themeMagic, sizeof(themeMagic));
+        header.version = themeVersion;
+        header.nameCount = (uint32_t)names.size();
+        header.nameBytes = offsets.back();
+        header.colourCount = (uint32_t)colours.size();
+        header.fontCount = (uint32_t)fonts.size();
+
+        std::vector<uint8_t> res;
+        auto append = [&res](const void *d, size_t n) {
+            auto b = (const uint8_t *)d;
+            res.insert(res.end(), b, b + n);
+        };
+        append(&header, sizeof(header));
+        append(offsets.data(), offsets.size() * sizeof(uint32_t));
+        for (auto &n : names)
+            append(n.data(), n.size());
+        append(colours.data(), colours.size() * sizeof(ThemeColour));
+        append(fonts.data(), fonts.size() * sizeof(ThemeFont));
+        return res;
+    }
+};
+
+// A validated view onto a binary theme; it points into the caller's buffer
+struct ThemeReader
+{
+    ThemeHeader header{};
+    const uint8_t *offsets{nullptr}, *names{nullptr}, *colours{nullptr}, *fonts{nullptr};
+
+    bool open(const void *data, size_t size)
+    {
+        auto d = (const uint8_t *)data;
+        if (!d || size < sizeof(ThemeHeader))
+            return false;
+        memcpy(&header, d, sizeof(header));
+        if (memcmp(header.magic, themeMagic, sizeof(themeMagic)) != 0 ||
+            header.version != themeVersion || header.nameCount > 0xFFFF)
+            return false;
+
+        auto offsetBytes = ((size_t)header.nameCount + 1) * sizeof(uint32_t);
+        auto need = sizeof(ThemeHeader) + offsetBytes + header.nameBytes +
+                    (size_t)header.colourCount * sizeof(ThemeColour) +
+                    (size_t)header.fontCount * sizeof(ThemeFont);
+        if (size < need)
+            return false;
+
+        offsets = d + sizeof(ThemeHeader);
+        names = offsets + offsetBytes;
+        colours = names + header.nameBytes;
+        fonts = colours + (size_t)header.colourCount * sizeof(ThemeColour);
+
+        for (uint32_t i = 0; i < header.nameCount; ++i)
+        {
+            auto [b, e] = nameRange(i);
+            if (b > e || e > header.nameBytes)
+                return false;
+        }
+        for (uint32_t i = 0; i < header.colourCount; ++i)
+        {
+            auto c = colour(i);
+            if (c.classIdx >= header.nameCount || c.propertyIdx >= header.nameCount)
+                return false;
+        }
+        for (uint32_t i = 0; i < header.fontCount; ++i)
+        {
+            auto f = font(i);
+            if (f.classIdx >= header.nameCount || f.propertyIdx >= header.nameCount ||
+                f.typefaceIdx >= header.nameCount)
+                return false;
+        }
+        return true;
+    }
+
+    std::pair<uint32_t, uint32_t> nameRange(uint32_t i) const
+    {
+        uint32_t r[2];
+        memcpy(r, offsets + i * sizeof(uint32_t), sizeof(r));
+        return {r[0], r[1]};
+    }
+    std::string_view name(uint32_t i) const
+    {
+        auto [b, e] = nameRange(i);
+        return {(const char *)names + b, e - b};
+    }
+    ThemeColour colour(uint32_t i) const
+    {
+        ThemeColour res;
+        memcpy(&res, colours + i * sizeof(ThemeColour), sizeof(res));
+        return res;
+    }
+    ThemeFont font(uint32_t i) const
+    {
+        ThemeFont res;
+        memcpy(&res, fonts + i * sizeof(ThemeFont), sizeof(res));
+        return res;
+    }
+};
+
+std::vector<uint8_t> StyleSheet::toBinaryTheme() const
+{
+    ThemeWriter w;
+    w.header.sliderGutterWidth = sliderGutterWidth;
+    w.header.sliderHandleRadius = sliderHandleRadius;
+    w.header.knobRingStrokeWide = knobRingStrokeWide;
+    w.header.knobRingStrokeNarrow = knobRingStrokeNarrow;
+    w.header.knobRingStrokeThreshold = knobRingStrokeThreshold;
+    w.header.fontHeightDelta = fontHeightDelta;
+    w.header.fontExtraKerningFactor = fontExtraKerningFactor;
+
+    forEachDirectDefinition([&w](int c, int p, auto *colour, auto *df) {
+        auto &cn = classNamesById[(size_t)c];
+        auto &pn = propertyNamesById[(size_t)p];
+        if (colour)
+        {
+            w.addColour(cn, pn, *colour);
+            return;
+        }
+        auto &font = *df->font;
+        w.addFont(cn, pn, font.getTypefaceName().toStdString(), font.getStyleFlags(),
+                  font.getHeight(), df->baselineHeight, font.getExtraKerningFactor(),
+                  df->replacedTypeface ? ThemeFont::replacedTypeface : 0);
+    });
+    return w.bytes();
+}
+
+StyleSheet::ptr_t StyleSheet::fromBinaryTheme(const void *data, size_t size,
+                                               const juce::Typeface::Ptr &replacedTypeface)
+{
+    ThemeReader r;
+    if (!r.open(data, size))
+        return nullptr;
+
+    // A replaced typeface is only a name here; rather than silently swap in whatever
+    // that name finds, insist on being handed the typeface to put back
+    for (uint32_t i = 0; i < r.header.fontCount; ++i)
+        if ((r.font(i).flags & ThemeFont::replacedTypeface) && !replacedTypeface)
+            return nullptr;
+
+    auto res = std::make_shared<StyleSheetBuiltInImpl>();
+    res->sliderGutterWidth = r.header.sliderGutterWidth;
+    res->sliderHandleRadius = r.header.sliderHandleRadius;
+    res->knobRingStrokeWide = r.header.knobRingStrokeWide;
+    res->knobRingStrokeNarrow = r.header.knobRingStrokeNarrow;
+    res->knobRingStrokeThreshold = r.header.knobRingStrokeThreshold;
+    res->fontHeightDelta = r.header.fontHeightDelta;
+    res->fontExtraKerningFactor = r.header.fontExtraKerningFactor;
+
+    // Map each name to its registry id once, registering names this process hasn't seen
+    std::vector<int> classIds(r.header.nameCount, -1), propertyIds(r.header.nameCount, -1);
+    auto classId = [&](uint16_t i) {
+        if (classIds[i] < 0)
+            classIds[i] = classIdForName(hashName(r.name(i)), r.name(i));
+        return classIds[i];
+    };
+    auto propertyId = [&](uint16_t i) {
+        if (propertyIds[i] < 0)
+            propertyIds[i] = propertyIdForName(hashName(r.name(i)), r.name(i));
+        return propertyIds[i];
+    };
+    for (uint32_t i = 0; i < r.header.colourCount; ++i)
+    {
+        auto c = r.colour(i);
+        classId(c.classIdx);
+        propertyId(c.propertyIdx);
+    }
+    for (uint32_t i = 0; i < r.header.fontCount; ++i)
+    {
+        auto f = r.font(i);
+        classId(f.classIdx);
+        propertyId(f.propertyIdx);
+    }
+
+    // With every id known, size the tables once so the entries below only fill slots
+    auto maxC = (int)registeredClassCount() - 1, maxP = (int)registeredPropertyCount() - 1;
+    res->colours.reserveFor(maxC, maxP);
+    res->colours.values.reserve(r.header.colourCount);
+    res->fonts.reserveFor(maxC, maxP);
+    res->fonts.values.reserve(r.header.fontCount);
+
+    for (uint32_t i = 0; i < r.header.colourCount; ++i)
+    {
+        auto c = r.colour(i);
+        res->colours.set(classIds[c.classIdx], propertyIds[c.propertyIdx],
+                         juce::Colour(c.argb));
+    }
+    for (uint32_t i = 0; i < r.header.fontCount; ++i)
+    {
+        auto f = r.font(i);
+        auto replaced = (f.flags & ThemeFont::replacedTypeface) != 0;
+        auto font = replaced ? SST_JUCE_FONT_CTOR(replacedTypeface)
+                             : SST_JUCE_FONT_CTOR(juce::String(std::string(r.name(f.typefaceIdx))),
+                                                  f.height, f.styleFlags);
+        font.setHeight(f.height);
+        font.setExtraKerningFactor(f.kerning);
+        res->fonts.set(classIds[f.classIdx], propertyIds[f.propertyIdx],
+                       {font, f.baselineHeight, replaced, nullptr});
+    }
+    return res;
+}
+
+std::string StyleSheet::toJsonTheme() const
+{
+    auto bin = toBinaryTheme();
+    ThemeReader r;
+    if (!r.open(bin.data(), bin.size()))
+        return {};
+
+    auto str = [&r](uint16_t i) { return juce::String(std::string(r.name(i))); };
+    auto entryFor = [](juce::DynamicObject *o, const juce::String &cls) {
+        if (!o->hasProperty(cls))
+            o->setProperty(cls, new juce::DynamicObject());
+        return o->getProperty(cls).getDynamicObject();
+    };
+
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("version", (int)themeVersion);
+
+    juce::DynamicObject::Ptr geometry = new juce::DynamicObject();
+    geometry->setProperty("sliderGutterWidth", r.header.sliderGutterWidth);
+    geometry->setProperty("sliderHandleRadius", r.header.sliderHandleRadius);
+    geometry->setProperty("knobRingStrokeWide", r.header.knobRingStrokeWide);
+    geometry->setProperty("knobRingStrokeNarrow", r.header.knobRingStrokeNarrow);
+    geometry->setProperty("knobRingStrokeThreshold", r.header.knobRingStrokeThreshold);
+    root->setProperty("geometry", geometry.get());
+    root->setProperty("fontHeightDelta", r.header.fontHeightDelta);
+    root->setProperty("fontExtraKerningFactor", r.header.fontExtraKerningFactor);
+
+    juce::DynamicObject::Ptr colours = new juce::DynamicObject();
+    for (uint32_t i = 0; i < r.header.colourCount; ++i)
+    {
+        auto c = r.colour(i);
+        entryFor(colours.get(), str(c.classIdx))
+            ->setProperty(str(c.propertyIdx), juce::Colour(c.argb).toString());
+    }
+    root->setProperty("colours", colours.get());
+
+    juce::DynamicObject::Ptr fonts = new juce::DynamicObject();
+    for (uint32_t i = 0; i < r.header.fontCount; ++i)
+    {
+        auto f = r.font(i);
+        juce::DynamicObject::Ptr fo = new juce::DynamicObject();
+        fo->setProperty("typeface", str(f.typefaceIdx));
+        fo->setProperty("height", f.height);
+        fo->setProperty("baselineHeight", f.baselineHeight);
+        fo->setProperty("style", (int)f.styleFlags);
+        fo->setProperty("kerning", f.kerning);
+        if (f.flags & ThemeFont::replacedTypeface)
+            fo->setProperty("replacedTypeface", true);
+        entryFor(fonts.get(), str(f.classIdx))->setProperty(str(f.propertyIdx), fo.get());
+    }
+    root->setProperty("fonts", fonts.get());
+
+    return juce::JSON::toString(juce::var(root.get())).toStdString();
+}
+
+StyleSheet::ptr_t StyleSheet::fromJsonTheme(const std::string &json,
+                                             const juce::Typeface::Ptr &replacedTypeface)
+{
+    juce::var parsed;
+    auto result = juce::JSON::parse(json, parsed);
+    if (!result.wasOk() || !parsed.isObject())
+        return nullptr;
+
+    auto *root = parsed.getDynamicObject();
+    if ((int)root->getProperty("version") != (int)themeVersion)
+        return nullptr;
+
+    ThemeWriter w;
+    auto geometry = root->getProperty("geometry");
+    auto geom = [&geometry](const char *k, int d) { return (int)geometry.getProperty(k, d); };
+    w.header.sliderGutterWidth = geom("sliderGutterWidth", 8);
+    w.header.sliderHandleRadius = geom("sliderHandleRadius", 7);
+    w.header.knobRingStrokeWide = geom("knobRingStrokeWide", 5);
+    w.header.knobRingStrokeNarrow = geom("knobRingStrokeNarrow", 3);
+    w.header.knobRingStrokeThreshold = geom("knobRingStrokeThreshold", 21);
+    w.header.fontHeightDelta = (float)root->getProperty("fontHeightDelta");
+    w.header.fontExtraKerningFactor = (float)root->getProperty("fontExtraKerningFactor");
+
+    // Both sections are maps of class name to a map of property name to value
+    auto forEachEntry = [root](const char *section, auto &&f) {
+        auto *so = root->getProperty(section).getDynamicObject();
+        if (!so)
+            return;
+        for (auto &cls : so->getProperties())
+        {
+            auto *co = cls.value.getDynamicObject();
+            if (!co)
+                continue;
+            for (auto &prop : co->getProperties())
+                f(cls.name.toString().toStdString(), prop.name.toString().toStdString(),
+                  prop.value);
+        }
+    };
+    forEachEntry("colours", [&w](auto &&c, auto &&p, auto &v) {
+        w.addColour(c, p, juce::Colour::fromString(v.toString()));
+    });
+    forEachEntry("fonts", [&w](auto &&c, auto &&p, auto &v) {
+        auto height = (float)v.getProperty("height", 13.f);
+        w.addFont(c, p, v.getProperty("typeface", "<Sans-Serif>").toString().toStdString(),
+                  (int)v.getProperty("style", 0), height,
+                  (float)v.getProperty("baselineHeight", height),
+                  (float)v.getProperty("kerning", 0.f),
+                  (bool)v.getProperty("replacedTypeface", false) ? ThemeFont::replacedTypeface
+                                                                 : 0);
+    });
+
+    auto bin = w.bytes();
+    return fromBinaryTheme(bin.data(), bin.size(), replacedTypeface);
+}
+
 StyleSheet::Declaration StyleSheet::addClass(const sst::jucegui::style::StyleSheet::Class &c)
 {
     allClasses.insert(&c);
+    classIdFor(c);
     auto d = Declaration(c);
     return d;
 }
@@ -619,30 +1274,30 @@ StyleSheet::Declaration::withProperty(const sst::jucegui::style::StyleSheet::Pro
 {
     allProperties[&of].push_back(&p);
     classByProperty[&p] = &of;
-    validPairs.insert({of.cname, p.pname});
+    propertyIdFor(p);
+    validPairs.insert({classIdFor(of), propertyIdFor(p)});
     return *this;
 }
 
-std::set<std::pair<std::string, std::string>> StyleSheet::validPairs;
+std::set<std::pair<int, int>> StyleSheet::validPairs;
 bool StyleSheet::isValidPair(const sst::jucegui::style::StyleSheet::Class &c,
                              const sst::jucegui::style::StyleSheet::Property &p)
 {
-    auto res = validPairs.find({c.cname, p.pname}) != validPairs.end();
+    return isValidPairById(classIdFor(c), propertyIdFor(p));
+}
 
-    if (!res)
+bool StyleSheet::isValidPairById(int c, int p)
+{
+    if (validPairs.find({c, p}) != validPairs.end())
+        return true;
+
+    for (auto k : inheritFromToById[(size_t)c])
     {
-        if (inheritFromTo.find(c.cname) != inheritFromTo.end())
-        {
-            for (const auto &k : inheritFromTo[c.cname])
-            {
-                auto ivp = isValidPair({k.c_str()}, p);
-                if (ivp)
-                    return true;
-            }
-        }
+        if (isValidPairById(k, p))
+            return true;
     }
 
-    return res;
+    return false;
 }
 
 void StyleSheet::initializeStyleSheets(std::function<void()> userClassInitializers)
@@ -694,7 +1349,355 @@ void StyleSheet::initializeStyleSheets(std::function<void()> userClassInitialize
     userClassInitializers();
 }
 
-std::ostream &StyleSheet::dumpStyleSheetTo(std::ostream &os)
+void StyleSheet::noteChanged(const Class &c, const Property &p)
+{
+    bumpGeneration();
+    if (attachedConsumerCount == 0)
+        return;
+
+    pendingChanges.push_back({classIdFor(c), propertyIdFor(p), p.type});
+    if (batchDepth == 0)
+        dispatchPendingChanges();
+}
+
+void StyleSheet::noteEverythingChanged()
+{
+    bumpGeneration();
+    if (attachedConsumerCount == 0)
+        return;
+
+    pendingEverything = true;
+    if (batchDepth == 0)
+        dispatchPendingChanges();
+}
+
+void StyleSheet::commitBatch()
+{
+    jassert(batchDepth > 0);
+    if (batchDepth == 0 || --batchDepth > 0)
+        return;
+
+    if (attachedConsumerCount > 0)
+        dispatchPendingChanges();
+    pendingChanges.clear();
+    pendingEverything = false;
+}
+
+void StyleSheet::markAffected(int classId, int propertyId, Property::Type type, bool isOrigin,
+                              std::vector<bool> &visited, std::vector<bool> &affected) const
+{
+    if (visited[(size_t)classId])
+        return;
+    visited[(size_t)classId] = true;
+
+    // A derived class with its own value for the property doesn't see the change
+    if (!isOrigin && definesById(classId, propertyId, type))
+        return;
+
+    affected[(size_t)classId] = true;
+    for (auto d : derivedClassesById[(size_t)classId])
+        markAffected(d, propertyId, type, false, visited, affected);
+}
+
+void StyleSheet::dispatchPendingChanges()
+{
+    std::vector<StyleConsumer *> targets;
+    if (pendingEverything)
+    {
+        targets.reserve(attachedConsumerCount);
+        for (const auto &b : consumersByClass)
+            targets.insert(targets.end(), b.begin(), b.end());
+    }
+    else if (!pendingChanges.empty())
+    {
+        std::vector<bool> affected(registeredClassCount(), false), visited;
+        for (const auto &pc : pendingChanges)
+        {
+            visited.assign(affected.size(), false);
+            markAffected(pc.classId, pc.propertyId, pc.type, true, visited, affected);
+        }
+
+        for (size_t cid = 0; cid < consumersByClass.size(); ++cid)
+        {
+            if (affected[cid])
+                targets.insert(targets.end(), consumersByClass[cid].begin(),
+                               consumersByClass[cid].end());
+        }
+    }
+    pendingChanges.clear();
+    pendingEverything = false;
+
+    /*
+     * Notify from a copy; onStyleChanged may lazily style new children which attach, or
+     * delete other targets, which detach and so are nulled out of the copy.
+     */
+    activeDispatches.push_back(&targets);
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        auto *sc = targets[i];
+        if (!sc)
+            continue;
+        sc->onStyleChanged();
+        if (!targets[i])
+            continue;
+        auto jc = sc->styledComponent();
+        if (jc && jc->isShowing())
+            jc->repaint();
+    }
+    activeDispatches.pop_back();
+}
+
+void StyleSheet::attachConsumer(StyleConsumer *sc)
+{
+    jassert(!sc->attachedSheet);
+    auto cid = (size_t)classIdFor(sc->getStyleClass());
+    if (consumersByClass.size() <= cid)
+        consumersByClass.resize(cid + 1);
+
+    auto &bucket = consumersByClass[cid];
+    sc->attachedSheet = this;
+    sc->attachedClassId = (int)cid;
+    sc->attachedIndex = bucket.size();
+    bucket.push_back(sc);
+    attachedConsumerCount++;
+}
+
+void StyleSheet::detachConsumer(StyleConsumer *sc)
+{
+    jassert(sc->attachedSheet == this);
+    auto &bucket = consumersByClass[(size_t)sc->attachedClassId];
+    auto idx = sc->attachedIndex;
+    jassert(idx < bucket.size() && bucket[idx] == sc);
+
+    bucket[idx] = bucket.back();
+    bucket[idx]->attachedIndex = idx;
+    bucket.pop_back();
+
+    sc->attachedSheet = nullptr;
+    sc->attachedClassId = -1;
+    attachedConsumerCount--;
+
+    for (auto *d : activeDispatches)
+        std::replace(d->begin(), d->end(), sc, (StyleConsumer *)nullptr);
+}
+
+StyleSheet::Snapshot::ptr_t StyleSheet::snapshot()
+{
+    if (latestSnapshot && latestSnapshot->generation == generation &&
+        latestSnapshot->inheritanceEpoch == inheritanceEpoch)
+        return latestSnapshot;
+
+    auto res = std::make_shared<Snapshot>();
+    res->generation = generation;
+    res->inheritanceEpoch = inheritanceEpoch;
+    res->rows = registeredClassCount();
+    res->stride = registeredPropertyCount();
+    res->slots.assign(res->rows * res->stride, -1);
+
+    res->sliderGutterWidth = getSliderGutterWidth();
+    res->sliderHandleRadius = getSliderHandleRadius();
+    res->knobRingStrokeWide = knobRingStrokeWide;
+    res->knobRingStrokeNarrow = knobRingStrokeNarrow;
+    res->knobRingStrokeThreshold = knobRingStrokeThreshold;
+
+    // A class answers for its own properties and everything it inherits
+    std::unordered_set<const Property *> props;
+    std::function<void(const Class *)> collect = [&](auto c) {
+        auto ap = allProperties.find(c);
+        if (ap != allProperties.end())
+            props.insert(ap->second.begin(), ap->second.end());
+        auto ih = inheritanceStructureDerivedFrom.find(c);
+        if (ih != inheritanceStructureDerivedFrom.end())
+            for (auto *b : ih->second)
+                collect(b);
+    };
+
+    for (auto *c : allClasses)
+    {
+        props.clear();
+        collect(c);
+        auto row = (size_t)classIdFor(*c) * res->stride;
+        for (auto *p : props)
+        {
+            auto &slot = res->slots[row + (size_t)propertyIdFor(*p)];
+            if (p->type == Property::COLOUR)
+            {
+                auto v = getColourOptional(*c, *p);
+                if (v.has_value())
+                {
+                    slot = (int32_t)res->colours.size();
+                    res->colours.push_back(*v);
+                }
+            }
+            else if (getFontOptional(*c, *p).has_value())
+            {
+                slot = (int32_t)res->fonts.size();
+                res->fonts.push_back(getFontHandle(*c, *p));
+            }
+        }
+    }
+
+    latestSnapshot = res;
+    return latestSnapshot;
+}
+
+int32_t StyleSheet::Snapshot::slotFor(const Class &c, const Property &p) const
+{
+    // Read the cached ids only; an unregistered class or property isn't in the snapshot
+    if (c.id < 0 || p.id < 0 || (size_t)c.id >= rows || (size_t)p.id >= stride)
+        return -1;
+    return slots[(size_t)c.id * stride + (size_t)p.id];
+}
+
+bool StyleSheet::Snapshot::hasColour(const Class &c, const Property &p) const
+{
+    return p.type == Property::COLOUR && slotFor(c, p) >= 0;
+}
+
+juce::Colour StyleSheet::Snapshot::getColour(const Class &c, const Property &p) const
+{
+    return getColourOptional(c, p).value_or(juce::Colours::red);
+}
+
+std::optional<juce::Colour> StyleSheet::Snapshot::getColourOptional(const Class &c,
+                                                                    const Property &p) const
+{
+    auto s = slotFor(c, p);
+    if (p.type != Property::COLOUR || s < 0)
+        return std::nullopt;
+    return colours[(size_t)s];
+}
+
+bool StyleSheet::Snapshot::hasFont(const Class &c, const Property &p) const
+{
+    return p.type == Property::FONT && slotFor(c, p) >= 0;
+}
+
+juce::Font StyleSheet::Snapshot::getFont(const Class &c, const Property &p) const
+{
+    return getFontHandle(c, p)->font;
+}
+
+FontHandle::ptr_t StyleSheet::Snapshot::getFontHandle(const Class &c, const Property &p) const
+{
+    auto s = slotFor(c, p);
+    if (p.type != Property::FONT || s < 0)
+    {
+        static const auto missing =
+            std::make_shared<const FontHandle>(SST_JUCE_FONT_CTOR(36, juce::Font::italic));
+        return missing;
+    }
+    return fonts[(size_t)s];
+}
+
+struct MissingStyleRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<uint64_t, size_t> indexByPair;
+    std::vector<StyleSheet::MissingStyle> entries;
+};
+
+static MissingStyleRegistry &missingStyleRegistry()
+{
+    static MissingStyleRegistry res;
+    return res;
+}
+
+void StyleSheet::noteMissing(const Class &c, const Property &p)
+{
+    auto key = ((uint64_t)(uint32_t)classIdFor(c) << 32) | (uint32_t)propertyIdFor(p);
+    auto &reg = missingStyleRegistry();
+    std::lock_guard<std::mutex> g(reg.mutex);
+
+    auto [it, inserted] = reg.indexByPair.try_emplace(key, reg.entries.size());
+    if (!inserted)
+    {
+        reg.entries[it->second].hits++;
+        return;
+    }
+
+    reg.entries.push_back({std::string(c.name), std::string(p.name), p.type, 1});
+    std::cout << __FILE__ << ":" << __LINE__
+              << (p.type == Property::COLOUR ? " COLOUR" : " FONT") << " Missing : " << c.cname
+              << "::" << p.pname << " (reported once; see getMissingStyles)\n";
+}
+
+std::vector<StyleSheet::MissingStyle> StyleSheet::getMissingStyles()
+{
+    auto &reg = missingStyleRegistry();
+    std::lock_guard<std::mutex> g(reg.mutex);
+    return reg.entries;
+}
+
+void StyleSheet::clearMissingStyles()
+{
+    auto &reg = missingStyleRegistry();
+    std::lock_guard<std::mutex> g(reg.mutex);
+    reg.indexByPair.clear();
+    reg.entries.clear();
+}
+
+std::ostream &StyleSheet::dumpMissingStylesTo(std::ostream &os)
+{
+    auto ms = getMissingStyles();
+    std::sort(ms.begin(), ms.end(), [](auto &a, auto &b) { return a.hits > b.hits; });
+
+    os << "Missing Styles (" << ms.size() << ")\n";
+    for (auto &m : ms)
+        os << "    " << (m.type == Property::COLOUR ? "COLOUR " : "FONT   ") << m.className
+           << "::" << m.propertyName << " x" << m.hits << "\n";
+    return os;
+}
+
+static void dumpLookupProfileTo(std::ostream &os)
+{
+    os << "\nLookup Profile\n";
+#if SST_JUCEGUI_STYLE_PROFILING
+    auto &lp = LookupProfile::get();
+    std::vector<std::pair<uint64_t, LookupProfile::Entry>> entries;
+    {
+        std::lock_guard<std::mutex> g(lp.mutex);
+        entries.assign(lp.entries.begin(), lp.entries.end());
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](auto &a, auto &b) { return a.second.nanos > b.second.nanos; });
+
+    uint64_t totalCount{0}, totalNanos{0};
+    for (auto &[k, e] : entries)
+    {
+        totalCount += e.count;
+        totalNanos += e.nanos;
+    }
+    os << "    " << totalCount << " lookups, " << totalNanos / 1000 << "us\n";
+
+    for (auto &[k, e] : entries)
+    {
+        auto c = (size_t)(k >> 32), p = (size_t)(k & 0xFFFFFFFF);
+        os << "    |-- " << StyleSheet::classNamesById[c] << "::"
+           << StyleSheet::propertyNamesById[p] << " n=" << e.count << " t=" << e.nanos / 1000
+           << "us mean=" << e.nanos / e.count << "ns depth=[";
+        for (size_t d = 0; d < LookupProfile::maxDepth; ++d)
+            os << (d ? " " : "") << e.depths[d];
+        os << "]";
+        if (e.misses)
+            os << " missing=" << e.misses;
+        os << "\n";
+    }
+#else
+    os << "    not collected; configure with -DSST_JUCEGUI_STYLE_PROFILING=TRUE\n";
+#endif
+}
+
+void StyleSheet::resetLookupProfile()
+{
+#if SST_JUCEGUI_STYLE_PROFILING
+    auto &lp = LookupProfile::get();
+    std::lock_guard<std::mutex> g(lp.mutex);
+    lp.entries.clear();
+#endif
+}
+
+std::ostream &StyleSheet::dumpStyleSheetTo(std::ostream &os, bool withLookupProfile)
 {
     os << "StyleSheet Dump"
        << "\n";
@@ -778,6 +1781,9 @@ std::ostream &StyleSheet::dumpStyleSheetTo(std::ostream &os)
         rprint(c, "|");
     }
 
+    if (withLookupProfile)
+        dumpLookupProfileTo(os);
+
     os << std::flush;
     return os;
 }